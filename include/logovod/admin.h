@@ -0,0 +1,180 @@
+/*
+ * Copyright (C) 2024 Eugene Hutorny <eugene@hutorny.in.ua>
+ *
+ * This file is a part of logovod library
+ *
+ * Licensed under MIT License, see full text in LICENSE
+ * or visit page https://opensource.org/license/mit/
+ */
+
+#pragma once
+#include <logovod/config.h>
+#include <logovod/shedding.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#include <poll.h>
+#include <unistd.h>
+#include <atomic>
+#include <cerrno>
+#include <cstdio>
+#include <filesystem>
+#include <string>
+#include <thread>
+
+// Administrative interface over a Unix-domain socket.
+// A client connects, sends a single command line and receives the response till the end of stream:
+//   list                       - registered categories with their effective level and sink
+//   level <pattern> <level>    - sets level of matching categories
+//   sink <pattern> <sink>      - routes matching categories to a named sink
+//   site <file:line> <level>   - enables statements of the level at the call site
+//   config                     - currently applied configuration
+//   stats                      - performance counters and load shedding pressure metrics
+// Changes are appended to the current configuration and are replaced by the next load of it.
+// See tools/logovodctl.cxx for a command line client
+namespace logovod::admin {
+
+// Executes a command and returns its response
+inline std::string execute(std::string_view command) {
+    const auto next = [&command]() {
+        while (!command.empty() && config::detail::is_separator(command.front())) command.remove_prefix(1);
+        std::size_t end {};
+        while (end < command.size() && !config::detail::is_separator(command[end])) ++end;
+        const auto word { command.substr(0, end) };
+        command.remove_prefix(end);
+        return word;
+    };
+    const auto verb { next() };
+    if (verb == "list") {
+        std::string result;
+        logovod::detail::registry::for_each([&result](const logovod::detail::category_entry& entry) {
+            result.append(entry.tag).append(" ").append(config::level_name(entry.level()));
+            if (entry.writer != nullptr) {
+                const auto name { config::sink_name(entry.writer()) };
+                result.append(" ").append(name.empty() ? "custom" : name);
+            }
+            result.append("\n");
+        });
+        return result;
+    }
+    if (verb == "level" || verb == "sink" || verb == "site") {
+        const auto target { next() };
+        const auto value { next() };
+        if (target.empty() || value.empty() || !next().empty()) return "error: invalid arguments\n";
+        std::string rule { verb == "site" ? "@" : "" };
+        rule.append(target).append(verb == "sink" ? "=>" : "=").append(value);
+        return config::append(rule) ? "ok\n" : "error: invalid rule " + rule + "\n";
+    }
+    if (verb == "config") return config::specification() + "\n";
+    if (verb == "stats") {
+        const auto values { logovod::detail::counters::snapshot() };
+        std::string result;
+        for (std::size_t i = 0; i < values.size(); ++i) {
+            result.append(logovod::detail::counters::names[i]).append(" ").append(std::to_string(values[i])).append("\n");
+        }
+        const auto pressure { shedding::governor::snapshot() };
+        result.append("latency_ns ").append(std::to_string(pressure.latency.count())).append("\n")
+              .append("depth ").append(std::to_string(pressure.depth)).append("\n")
+              .append("shedding ").append(pressure.shedding ? "1" : "0").append("\n")
+              .append("shedding_transitions ").append(std::to_string(pressure.transitions)).append("\n");
+        return result;
+    }
+    if (verb == "help" || verb.empty()) return "commands: list, level <pattern> <level>, sink <pattern> <sink>, "
+        "site <file:line> <level>, config, stats\n";
+    return "error: unknown command " + std::string { verb } + "\n";
+}
+
+// Serves administrative commands on a Unix-domain socket at the given path in a background thread.
+// An existing socket file at the path is replaced, the file is removed on destruction.
+// The socket is accessible to the owner only (mode 0600), clients wait no longer than the timeout
+class server {
+public:
+    explicit server(std::filesystem::path path) : path_ { std::move(path) } {
+        sockaddr_un address {};
+        address.sun_family = AF_UNIX;
+        if (path_.native().size() >= sizeof(address.sun_path) || ::pipe(stop_) != 0) return;
+        path_.native().copy(address.sun_path, sizeof(address.sun_path) - 1);
+        // non-blocking, so that a connection dropped between poll and accept does not block the server
+        socket_ = ::socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC | SOCK_NONBLOCK, 0);
+        if (socket_ == -1) return;
+        ::unlink(path_.c_str());
+        if (::bind(socket_, reinterpret_cast<const sockaddr*>(&address), sizeof(address)) != 0) return;
+        bound_ = true;
+        // connections are refused until listen, so the socket is restricted before any client gets in
+        if (::chmod(path_.c_str(), S_IRUSR | S_IWUSR) != 0 || ::listen(socket_, 4) != 0) return;
+        thread_ = std::thread { [this]() { run(); } };
+    }
+    server(const server&) = delete;
+    server(server&&) = delete;
+    server& operator=(const server&) = delete;
+    server& operator=(server&&) = delete;
+    ~server() {
+        if (thread_.joinable()) {
+            const char stop {};
+            static_cast<void>(::write(stop_[1], &stop, 1));
+            thread_.join();
+        }
+        for (auto fd : { socket_, stop_[0], stop_[1] }) if (fd != -1) ::close(fd);
+        if (bound_) ::unlink(path_.c_str());
+    }
+    // Whether the server is accepting connections
+    bool active() const noexcept { return thread_.joinable(); }
+    // Number of commands served
+    unsigned served() const noexcept { return served_.load(std::memory_order_acquire); }
+private:
+    static constexpr int timeout = 1000; // ms, for a client to send the command or to take the response
+    // Waits for the client to be ready for the events, returns false on timeout, error or stop
+    bool wait(int client, short events) const noexcept {
+        pollfd fds[] { { client, events, 0 }, { stop_[0], POLLIN, 0 } };
+        for (;;) {
+            const auto ready { ::poll(fds, 2, timeout) };
+            if (ready == -1 && errno == EINTR) continue;
+            return ready > 0 && (fds[1].revents & POLLIN) == 0 && (fds[0].revents & events) != 0;
+        }
+    }
+    void serve(int client) {
+        std::string command;
+        char buffer[256];
+        while (command.find('\n') == command.npos && command.size() < 4096) {
+            if (!wait(client, POLLIN)) return;
+            const auto size { ::read(client, buffer, sizeof(buffer)) };
+            if (size == -1 && (errno == EAGAIN || errno == EWOULDBLOCK || errno == EINTR)) continue;
+            if (size <= 0) break;
+            command.append(buffer, static_cast<std::size_t>(size));
+        }
+        const auto response { execute(command.substr(0, command.find('\n'))) };
+        for (std::size_t pos {}; pos < response.size(); ) {
+            // the client socket is non-blocking, a client not reading the response times out
+            if (!wait(client, POLLOUT)) return;
+            const auto size { ::send(client, response.data() + pos, response.size() - pos, MSG_NOSIGNAL) };
+            if (size == -1 && (errno == EAGAIN || errno == EWOULDBLOCK || errno == EINTR)) continue;
+            if (size <= 0) return;
+            pos += static_cast<std::size_t>(size);
+        }
+        served_.fetch_add(1, std::memory_order_release);
+    }
+    void run() {
+        pollfd fds[] { { socket_, POLLIN, 0 }, { stop_[0], POLLIN, 0 } };
+        for (;;) {
+            if (::poll(fds, 2, -1) == -1) {
+                // revents are not updated by an interrupted poll
+                if (errno == EINTR) continue;
+                return;
+            }
+            if ((fds[1].revents & POLLIN) != 0) return;
+            if ((fds[0].revents & POLLIN) == 0) continue;
+            const auto client { ::accept4(socket_, nullptr, nullptr, SOCK_CLOEXEC | SOCK_NONBLOCK) };
+            if (client == -1) continue;
+            serve(client);
+            ::close(client);
+        }
+    }
+    std::filesystem::path path_;
+    int socket_ { -1 };
+    int stop_[2] { -1, -1 };
+    bool bound_ {};
+    std::atomic<unsigned> served_ {};
+    std::thread thread_ {};
+};
+
+} // namespace logovod::admin
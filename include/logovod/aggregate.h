@@ -0,0 +1,169 @@
+/*
+ * Copyright (C) 2024 Eugene Hutorny <eugene@hutorny.in.ua>
+ *
+ * This file is a part of logovod library
+ *
+ * Licensed under MIT License, see full text in LICENSE
+ * or visit page https://opensource.org/license/mit/
+ */
+
+#pragma once
+#include <logovod/limit.h>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <string>
+#include <thread>
+
+// Aggregation mode. Statements of an aggregated category are counted per call site instead of being written,
+// one in Sample statements is formatted to keep a sample of its arguments. Summaries, such as
+// site server.cxx:120 fired 1200000 times in 10000 ms, last: request 42 served
+// are written with the base category by aggregate::report(), called explicitly or periodically by aggregate::reporter
+namespace logovod::aggregate {
+namespace detail {
+
+struct site {
+    static constexpr std::size_t sample_size = 128;
+    std::atomic<std::uint64_t> key;
+    std::atomic<const char*> file;
+    std::atomic<std::uint_least32_t> line;
+    std::atomic<std::uint64_t> count;
+    std::atomic<priority> level;
+    // sample of arguments, guarded by busy
+    std::atomic<bool> busy;
+    char sample[sample_size];
+    std::size_t size;
+    void claim(const char* f, std::uint_least32_t l) noexcept {
+        file.store(f, std::memory_order_release);
+        line.store(l, std::memory_order_release);
+    }
+    // Stores a sample of arguments, skipped if the slot is busy
+    void store(std::string_view payload, priority p) noexcept {
+        if (busy.exchange(true, std::memory_order_acquire)) return;
+        size = payload.copy(sample, sample_size);
+        level.store(p, std::memory_order_relaxed);
+        busy.store(false, std::memory_order_release);
+    }
+    std::string load() noexcept {
+        while (busy.exchange(true, std::memory_order_acquire)) std::this_thread::yield();
+        std::string result { sample, size };
+        busy.store(false, std::memory_order_release);
+        return result;
+    }
+};
+
+// Aggregated categories, registered on first use, for reporting
+class registry {
+public:
+    struct node {
+        void (*report)();
+        node* next;
+    };
+    static void add(node& n) noexcept {
+        std::lock_guard<std::mutex> lock { mutex() };
+        n.next = head();
+        head() = &n;
+    }
+    static void report() {
+        std::lock_guard<std::mutex> lock { mutex() };
+        for (auto n { head() }; n != nullptr; n = n->next) n->report();
+    }
+private:
+    static std::mutex& mutex() noexcept { static std::mutex instance {}; return instance; }
+    static node*& head() noexcept { static node* instance {}; return instance; }
+};
+
+// Summaries are written with the base category under the tag of the aggregated one
+template<class Category, class Base>
+struct summary : Base {
+    static constexpr std::string_view tag = Category::tag;
+};
+
+template<class Category, class Base, std::uint32_t Sample>
+class policy {
+public:
+    using sites = limit::detail::sites<Category, policy, site>;
+    template<class>
+    limit::decision admit(const source_location& sl) const noexcept {
+        [[maybe_unused]] static const bool registered { (registry::add(node_), true) };
+        const auto s { sites::find(sl) };
+        if (s == nullptr) return { false, 0 };
+        return { s->count.fetch_add(1, std::memory_order_relaxed) % Sample == 0, 0 };
+    }
+    // Receives formatted samples, in place of the writer
+    static void capture(std::string_view, std::string_view payload, attributes attrs) noexcept {
+        const auto s { sites::find(attrs.location.file_name.data(), attrs.location.line) };
+        if (s != nullptr) s->store(payload, attrs.level);
+    }
+    static void report() {
+        using namespace std::chrono;
+        const auto now { steady_clock::now().time_since_epoch().count() };
+        const auto previous { last_.exchange(now, std::memory_order_relaxed) };
+        const auto elapsed { duration_cast<milliseconds>(steady_clock::duration { now - previous }).count() };
+        sites::for_each([elapsed](site& s) {
+            const auto count { s.count.exchange(0, std::memory_order_relaxed) };
+            if (count == 0) return;
+            const auto file { s.file.load(std::memory_order_acquire) };
+            const std::string location { std::string { file != nullptr ? file : "" } + ':' + std::to_string(s.line.load(std::memory_order_acquire)) };
+            typename logger<summary<Category, Base>>::log(s.level.load(std::memory_order_relaxed),
+                "site", location, "fired", count, "times in", elapsed, "ms, last:", s.load());
+        });
+    }
+private:
+    static inline registry::node node_ { report, nullptr };
+    static inline std::atomic<std::chrono::steady_clock::rep> last_ { std::chrono::steady_clock::now().time_since_epoch().count() };
+};
+} // namespace detail
+
+// Writes summaries of all aggregated categories and resets their counters
+inline void report() {
+    detail::registry::report();
+}
+
+// Reports periodically in a background thread, and once more on destruction
+class reporter {
+public:
+    explicit reporter(std::chrono::milliseconds period) : period_ { period } {
+        thread_ = std::thread { [this]() { run(); } };
+    }
+    reporter(const reporter&) = delete;
+    reporter(reporter&&) = delete;
+    reporter& operator=(const reporter&) = delete;
+    reporter& operator=(reporter&&) = delete;
+    ~reporter() {
+        {
+            std::lock_guard<std::mutex> lock { mutex_ };
+            stop_ = true;
+        }
+        condition_.notify_one();
+        thread_.join();
+        report();
+    }
+private:
+    void run() {
+        std::unique_lock<std::mutex> lock { mutex_ };
+        while (!condition_.wait_for(lock, period_, [this]() { return stop_; })) {
+            lock.unlock();
+            report();
+            lock.lock();
+        }
+    }
+    std::chrono::milliseconds period_;
+    std::mutex mutex_ {};
+    std::condition_variable condition_ {};
+    bool stop_ {};
+    std::thread thread_ {};
+};
+
+} // namespace logovod::aggregate
+
+namespace logovod {
+
+// Counts statements per call site instead of writing them, keeping one in Sample of them as a sample of arguments
+template<class Category, class Base, std::uint32_t Sample = 1024>
+struct aggregated : Base {
+    static constexpr auto limiter() noexcept { return aggregate::detail::policy<Category, Base, Sample> {}; }
+    static constexpr auto writer() noexcept { return aggregate::detail::policy<Category, Base, Sample>::capture; }
+};
+
+} // namespace logovod
@@ -9,12 +9,138 @@
 
 #pragma once
 #include <logovod/core.h>
+#include <algorithm>
 #include <chrono>
+#include <ctime>
 #include <iomanip>
 
 namespace logovod {
+enum class time_precision { seconds, milliseconds, microseconds, nanoseconds };
+
 namespace detail {
 
+// Renders the wall time as YYYY-MM-DDTHH:MM:SS[.fraction], in the local time or UTC.
+// The text of the last rendered second is cached per thread. The UTC offset is cached
+// for a quarter of an hour, as time zone transitions happen at quarter hour boundaries
+class time_renderer {
+public:
+    static constexpr std::size_t max_size = 29;
+    static std::size_t render(char* out, std::chrono::system_clock::time_point tp, time_precision precision, bool utc) noexcept {
+        using namespace std::chrono;
+        constexpr std::int64_t giga = 1'000'000'000;
+        const auto since { duration_cast<nanoseconds>(tp.time_since_epoch()).count() };
+        auto seconds { since / giga };
+        auto nanos { since % giga };
+        if (nanos < 0) {
+            nanos += giga;
+            --seconds;
+        }
+        auto& c { cache_[utc ? 1 : 0] };
+        if (!c.valid || c.second != seconds) fill(c, seconds, utc);
+        std::copy(std::begin(c.text), std::end(c.text), out);
+        unsigned digits {};
+        switch (precision) {
+        case time_precision::seconds: return seconds_size;
+        case time_precision::milliseconds: digits = 3; nanos /= 1'000'000; break;
+        case time_precision::microseconds: digits = 6; nanos /= 1'000; break;
+        case time_precision::nanoseconds: digits = 9; break;
+        }
+        out[seconds_size] = '.';
+        put_digits(out + seconds_size + 1, static_cast<unsigned>(nanos), digits);
+        return seconds_size + 1 + digits;
+    }
+    template<typename Stream>
+    static Stream& print(Stream& out, std::chrono::system_clock::time_point tp, time_precision precision, bool utc) {
+        char text[max_size];
+        const auto size { render(text, tp, precision, utc) };
+        if constexpr (std::is_same_v<typename Stream::char_type, char>) {
+            out.write(text, static_cast<std::streamsize>(size));
+        } else {
+            for (std::size_t i = 0; i < size; ++i) out.put(out.widen(text[i]));
+        }
+        return out;
+    }
+private:
+    static constexpr std::size_t seconds_size = 19;
+    static constexpr std::int64_t quarter = 900;
+    struct cache {
+        std::int64_t second;
+        std::int64_t offset;
+        std::int64_t offset_since;
+        bool valid;
+        bool offset_valid;
+        char text[seconds_size];
+    };
+    static constexpr std::int64_t floor_div(std::int64_t a, std::int64_t b) noexcept {
+        return a / b - (a % b < 0 ? 1 : 0);
+    }
+    // Howard Hinnant's days_from_civil and civil_from_days
+    static constexpr std::int64_t days_from_civil(std::int64_t y, unsigned m, unsigned d) noexcept {
+        y -= m <= 2 ? 1 : 0;
+        const auto era { floor_div(y, 400) };
+        const auto yoe { static_cast<unsigned>(y - era * 400) };
+        const auto doy { (153 * (m + (m > 2 ? -3 : 9)) + 2) / 5 + d - 1 };
+        const auto doe { yoe * 365 + yoe / 4 - yoe / 100 + doy };
+        return era * 146097 + static_cast<std::int64_t>(doe) - 719468;
+    }
+    static void put_digits(char* out, unsigned value, unsigned digits) noexcept {
+        constexpr char pairs[] =
+            "00010203040506070809101112131415161718192021222324252627282930313233343536373839"
+            "40414243444546474849505152535455565758596061626364656667686970717273747576777879"
+            "8081828384858687888990919293949596979899";
+        for (auto pos { digits }; pos >= 2; pos -= 2, value /= 100) {
+            out[pos - 2] = pairs[value % 100 * 2];
+            out[pos - 1] = pairs[value % 100 * 2 + 1];
+        }
+        if (digits % 2 != 0) out[0] = static_cast<char>('0' + value % 10);
+    }
+    static std::int64_t utc_offset(std::int64_t seconds) noexcept {
+        ::tzset(); // localtime_r is not required to follow changes of TZ
+        const auto t { static_cast<std::time_t>(seconds) };
+        std::tm tm {};
+        if (::localtime_r(&t, &tm) == nullptr) return 0;
+        const auto local { days_from_civil(tm.tm_year + 1900, static_cast<unsigned>(tm.tm_mon + 1), static_cast<unsigned>(tm.tm_mday)) * 86400
+                           + tm.tm_hour * 3600 + tm.tm_min * 60 + tm.tm_sec };
+        return local - seconds;
+    }
+    static void fill(cache& c, std::int64_t seconds, bool utc) noexcept {
+        std::int64_t offset {};
+        if (!utc) {
+            const auto since { floor_div(seconds, quarter) * quarter };
+            if (!c.offset_valid || c.offset_since != since) {
+                c.offset = utc_offset(seconds);
+                c.offset_since = since;
+                c.offset_valid = true;
+            }
+            offset = c.offset;
+        }
+        const auto local { seconds + offset };
+        const auto days { floor_div(local, 86400) };
+        const auto time { static_cast<unsigned>(local - days * 86400) };
+        const auto z { days + 719468 };
+        const auto era { floor_div(z, 146097) };
+        const auto doe { static_cast<unsigned>(z - era * 146097) };
+        const auto yoe { (doe - doe / 1460 + doe / 36524 - doe / 146096) / 365 };
+        const auto doy { doe - (365 * yoe + yoe / 4 - yoe / 100) };
+        const auto mp { (5 * doy + 2) / 153 };
+        const auto day { doy - (153 * mp + 2) / 5 + 1 };
+        const auto month { mp < 10 ? mp + 3 : mp - 9 };
+        const auto year { static_cast<std::int64_t>(yoe) + era * 400 + (month <= 2 ? 1 : 0) };
+        put_digits(c.text, static_cast<unsigned>(year), 4);
+        put_digits(c.text + 5, month, 2);
+        put_digits(c.text + 8, day, 2);
+        put_digits(c.text + 11, time / 3600, 2);
+        put_digits(c.text + 14, time / 60 % 60, 2);
+        put_digits(c.text + 17, time % 60, 2);
+        c.text[4] = c.text[7] = '-';
+        c.text[10] = 'T';
+        c.text[13] = c.text[16] = ':';
+        c.second = seconds;
+        c.valid = true;
+    }
+    static inline thread_local cache cache_[2] {};
+};
+
 template<typename Clock>
 struct clock_printer {
     template<typename Stream, typename Duration>
@@ -25,19 +151,11 @@ template<>
 struct clock_printer<std::chrono::system_clock> {
     template<typename Stream, typename Duration>
     static Stream& print(Stream& out, std::chrono::time_point<std::chrono::system_clock, Duration> tp) {
-        std::time_t t = std::chrono::system_clock::to_time_t(tp);
-        out << std::put_time(std::localtime(&t), "%FT%T.");
-        if constexpr(std::is_floating_point_v<typename Duration::rep> || Duration::period::den >= 1000) {
-            auto millis = std::chrono::duration_cast<std::chrono::milliseconds>(tp.time_since_epoch()).count() % 1000;
-            auto flags { out.flags() };
-            auto width { out.width() };
-            auto fill { out.fill() };
-            out << std::dec << std::setw(3) << std::setfill('0') << millis;
-            out.fill(fill);
-            out.width(width);
-            out.flags(flags);
-        }
-        return out;
+        // the fraction of the second as fine as the time point, floating point time points are printed in nanoseconds
+        constexpr auto precision { std::is_floating_point_v<typename Duration::rep> || Duration::period::den >= 1'000'000'000 ?
+            time_precision::nanoseconds : Duration::period::den >= 1'000'000 ? time_precision::microseconds :
+            Duration::period::den >= 1'000 ? time_precision::milliseconds : time_precision::seconds };
+        return time_renderer::print(out, std::chrono::time_point_cast<std::chrono::system_clock::duration>(tp), precision, false);
     }
 };
 
@@ -0,0 +1,101 @@
+/*
+ * Copyright (C) 2024 Eugene Hutorny <eugene@hutorny.in.ua>
+ *
+ * This file is a part of logovod library
+ *
+ * Licensed under MIT License, see full text in LICENSE
+ * or visit page https://opensource.org/license/mit/
+ */
+
+#pragma once
+#include <logovod/chrono.h>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#if __has_include(<time.h>)
+#include <time.h>
+#endif
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif
+
+// Time sources in addition to clock::none and clock::system, defined in core.h
+namespace logovod::clock {
+
+// CLOCK_REALTIME_COARSE, cheaper than the system clock at the resolution of the scheduler tick.
+// Falls back to the system clock where not available
+struct coarse {
+    static std::uint64_t ticks() noexcept {
+#if defined(CLOCK_REALTIME_COARSE)
+        timespec ts;
+        ::clock_gettime(CLOCK_REALTIME_COARSE, &ts);
+        return static_cast<std::uint64_t>(ts.tv_sec) * 1'000'000'000u + static_cast<std::uint64_t>(ts.tv_nsec);
+#else
+        return system::ticks();
+#endif
+    }
+    static sys_time to_sys(std::uint64_t ticks) noexcept { return system::to_sys(ticks); }
+    static timestamp now() noexcept { return { ticks(), to_sys }; }
+};
+
+// CPU time stamp counter, the cheapest source, requires an invariant TSC.
+// Ticks are converted with the rate measured against the steady clock once, when the interval since
+// the start of the program is long enough for a precise rate, and estimated from the shorter interval before that.
+// The wall time is that of the reference point taken at the start, so steps of the system clock do not affect
+// conversions. Falls back to the steady clock on other architectures
+template<class SystemClock = std::chrono::system_clock, class SteadyClock = std::chrono::steady_clock>
+struct basic_tsc {
+    static std::uint64_t ticks() noexcept {
+#if defined(__x86_64__) || defined(__i386__)
+        return __rdtsc();
+#elif defined(__aarch64__)
+        std::uint64_t value;
+        asm volatile("mrs %0, cntvct_el0" : "=r"(value));
+        return value;
+#else
+        return static_cast<std::uint64_t>(SteadyClock::now().time_since_epoch().count());
+#endif
+    }
+    static sys_time to_sys(std::uint64_t ticks) noexcept {
+        using namespace std::chrono;
+        const auto offset { static_cast<double>(static_cast<std::int64_t>(ticks - reference_.ticks)) * rate() };
+        return reference_.time + duration_cast<sys_time::duration>(nanoseconds { static_cast<std::int64_t>(offset) });
+    }
+    static timestamp now() noexcept { return { ticks(), to_sys }; }
+private:
+    // Nanoseconds per tick
+    static double rate() noexcept {
+        using namespace std::chrono;
+        // shorter intervals give imprecise rates
+        constexpr nanoseconds calibration_interval { milliseconds { 100 } };
+        const auto cached { rate_.load(std::memory_order_relaxed) };
+        if (cached != 0) return cached;
+        const auto now { ticks() };
+        const auto elapsed { duration_cast<nanoseconds>(SteadyClock::now() - reference_.steady) };
+        if (now == reference_.ticks) return 0;
+        const auto estimate { static_cast<double>(elapsed.count()) / static_cast<double>(now - reference_.ticks) };
+        if (elapsed >= calibration_interval) rate_.store(estimate, std::memory_order_relaxed);
+        return estimate;
+    }
+    struct reference {
+        std::uint64_t ticks;
+        sys_time time;
+        typename SteadyClock::time_point steady;
+    };
+    static inline const reference reference_ { ticks(), SystemClock::now(), SteadyClock::now() };
+    static inline std::atomic<double> rate_ {};
+};
+
+using tsc = basic_tsc<>;
+
+} // namespace logovod::clock
+
+namespace logovod {
+template<>
+struct formatter<clock::timestamp> {
+    template<typename Printer, typename Stream>
+    void operator()(Printer&, Stream& stream, clock::timestamp value) {
+        detail::put_time_point(stream, value.to_sys());
+    }
+};
+} // namespace logovod
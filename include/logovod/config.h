@@ -0,0 +1,364 @@
+/*
+ * Copyright (C) 2024 Eugene Hutorny <eugene@hutorny.in.ua>
+ *
+ * This file is a part of logovod library
+ *
+ * Licensed under MIT License, see full text in LICENSE
+ * or visit page https://opensource.org/license/mit/
+ */
+
+#pragma once
+#include <logovod/core.h>
+#include <cstdlib>
+#include <fstream>
+#include <iterator>
+#include <limits>
+#include <mutex>
+#include <string>
+#include <vector>
+
+// Run-time configuration of registered categories with a textual specification, such as
+// net.*=debug,db=warning>cerr,@server.cxx:120=debug
+// Rules are separated with commas, spaces or new lines, # starts a comment till the end of line.
+// A category rule consists of a tag pattern, a level and/or a named sink: pattern=[level][>sink]
+// patterns may contain wildcards * and ?. When several rules match the same tag, the last one takes precedence.
+// Level or sink "default" resets the category to fall back on its base.
+// A call site rule @file:line=level enables statements of the given level at the call site,
+// file is matched against trailing components of the source file path.
+// The configuration is applied to categories registered at the time of loading and to those registered later.
+// Settings, applied by a previous configuration and not matched by the current one, are reset to default
+namespace logovod::config {
+namespace detail {
+
+using logovod::detail::glob_match;
+
+constexpr bool is_separator(char c) noexcept {
+    return c == ',' || c == ' ' || c == '\t' || c == '\n' || c == '\r';
+}
+
+// Iterates rules of a specification, calling function(pattern, value) for each.
+// Returns false on a malformed rule, rules preceding the malformed one are processed
+template<typename Function>
+bool for_each_rule(std::string_view spec, Function&& function) {
+    while (!spec.empty()) {
+        if (is_separator(spec.front())) {
+            spec.remove_prefix(1);
+            continue;
+        }
+        if (spec.front() == '#') {
+            const auto eol { spec.find('\n') };
+            spec.remove_prefix(eol == spec.npos ? spec.size() : eol);
+            continue;
+        }
+        std::size_t end {};
+        while (end < spec.size() && !is_separator(spec[end]) && spec[end] != '#') ++end;
+        const auto rule { spec.substr(0, end) };
+        spec.remove_prefix(end);
+        const auto eq { rule.rfind('=') };
+        if (eq == rule.npos || eq == 0 || eq + 1 == rule.size()) return false;
+        if (!function(rule.substr(0, eq), rule.substr(eq + 1))) return false;
+    }
+    return true;
+}
+
+} // namespace detail
+
+// Level values, that a level rule may assign
+enum class level_value { invalid, level, fallback, none };
+
+struct level_rule {
+    level_value kind;
+    priority level;
+};
+
+// Parses level name - full name, short name, shortcode, or syslog numeric value
+inline level_rule parse_level(std::string_view name) noexcept {
+    struct named { std::string_view name; priority level; };
+    static constexpr named names[] {
+        { "emergency", priority::emergency },   { "emerg", priority::emergency },   { "f", priority::emergency },
+        { "alert", priority::alert },           { "a", priority::alert },
+        { "critical", priority::critical },     { "crit", priority::critical },     { "c", priority::critical },
+        { "error", priority::error },           { "err", priority::error },         { "e", priority::error },
+        { "warning", priority::warning },       { "warn", priority::warning },      { "w", priority::warning },
+        { "notice", priority::notice },         { "n", priority::notice },
+        { "informational", priority::informational }, { "info", priority::informational }, { "i", priority::informational },
+        { "debug", priority::debug },           { "d", priority::debug },
+    };
+    if (name == "default") return { level_value::fallback, priority::debug };
+    if (name.size() == 1 && name[0] >= '0' && name[0] <= '7')
+        return { level_value::level, static_cast<priority>(name[0] - '0') };
+    for (const auto& n : names) {
+        if (n.name == name) return { level_value::level, n.level };
+    }
+    return { level_value::invalid, priority::debug };
+}
+
+// Full name of the level, as accepted by parse_level
+constexpr std::string_view level_name(priority level) noexcept {
+    constexpr std::string_view names[] {
+        "emergency", "alert", "critical", "error", "warning", "notice", "informational", "debug"
+    };
+    const auto index { static_cast<std::size_t>(level) };
+    return index < std::size(names) ? names[index] : std::string_view { "none" };
+}
+
+namespace detail {
+enum configured : unsigned { level = 1, sink = 2 };
+
+struct named_sink {
+    std::string name;
+    sink::bundle bundle;
+};
+
+struct state {
+    std::mutex mutex {};
+    std::string spec {};
+    std::vector<named_sink> sinks {
+        { "clog", { nullptr, sink::clog, nullptr } },
+        { "cout", { nullptr, sink::cout, nullptr } },
+        { "cerr", { nullptr, sink::cerr, nullptr } },
+    };
+    const named_sink* find(std::string_view name) const noexcept {
+        for (const auto& s : sinks) if (s.name == name) return &s;
+        return nullptr;
+    }
+};
+
+inline state& current() noexcept {
+    static state instance {};
+    return instance;
+}
+
+// Value of a category rule - [level][>sink]
+struct category_value {
+    level_rule level;
+    std::string_view sink;
+};
+
+inline category_value parse_value(std::string_view value) noexcept {
+    const auto gt { value.find('>') };
+    const auto level { value.substr(0, gt) };
+    const auto sink { gt == value.npos ? std::string_view {} : value.substr(gt + 1) };
+    if (gt != value.npos && sink.empty()) return { { level_value::invalid, priority::debug }, sink };
+    return { level.empty() ? level_rule { level_value::none, priority::debug } : parse_level(level), sink };
+}
+
+// Parses call site rule @file:line=level, returns false if the pattern is not a call site
+inline bool parse_site(std::string_view pattern, std::string_view value, logovod::detail::sites::rule& site, bool& valid) noexcept {
+    valid = false;
+    if (pattern.front() != '@') return false;
+    pattern.remove_prefix(1);
+    const auto colon { pattern.rfind(':') };
+    if (colon == pattern.npos || colon == 0 || colon + 1 == pattern.size() || colon >= sizeof(site.file)) return true;
+    std::uint_least32_t line {};
+    for (auto c : pattern.substr(colon + 1)) {
+        if (c < '0' || c > '9') return true;
+        line = line * 10 + static_cast<std::uint_least32_t>(c - '0');
+    }
+    const auto level { parse_level(value) };
+    if (level.kind != level_value::level || line == 0) return true;
+    site = {};
+    pattern.copy(site.file, colon);
+    site.line = line;
+    site.level = level.level;
+    valid = true;
+    return true;
+}
+
+inline bool validate(const state& state, std::string_view spec) {
+    std::size_t sites {};
+    return for_each_rule(spec, [&state, &sites](std::string_view pattern, std::string_view value) {
+        logovod::detail::sites::rule site;
+        bool valid;
+        if (parse_site(pattern, value, site, valid)) return valid && ++sites <= logovod::detail::sites::capacity;
+        const auto parsed { parse_value(value) };
+        if (parsed.level.kind == level_value::invalid) return false;
+        return parsed.sink.empty() || parsed.sink == "default" || state.find(parsed.sink) != nullptr;
+    });
+}
+
+// Applies the specification to a single category
+inline void apply_to(const state& state, const logovod::detail::category_entry& entry) {
+    level_rule level { level_value::none, priority::debug };
+    std::string_view sink {};
+    for_each_rule(state.spec, [&entry, &level, &sink](std::string_view pattern, std::string_view value) {
+        if (pattern.front() == '@' || !glob_match(pattern, entry.tag)) return true;
+        const auto parsed { parse_value(value) };
+        if (parsed.level.kind != level_value::none) level = parsed.level;
+        if (!parsed.sink.empty()) sink = parsed.sink;
+        return true;
+    });
+    if (level.kind == level_value::level && entry.set_level != nullptr) {
+        entry.set_level(level.level);
+        entry.configured |= configured::level;
+    } else if ((level.kind == level_value::fallback || (entry.configured & configured::level) != 0) && entry.reset_level != nullptr) {
+        entry.reset_level();
+        entry.configured &= ~configured::level;
+    }
+    const auto named { sink.empty() || sink == "default" ? nullptr : state.find(sink) };
+    if (named != nullptr && entry.set_sink != nullptr) {
+        entry.set_sink(named->bundle);
+        entry.configured |= configured::sink;
+    } else if ((sink == "default" || (entry.configured & configured::sink) != 0) && entry.reset_sink != nullptr) {
+        entry.reset_sink();
+        entry.configured &= ~configured::sink;
+    }
+}
+
+inline void apply_sites(const state& state) {
+    logovod::detail::sites::rule sites[logovod::detail::sites::capacity];
+    std::size_t size {};
+    for_each_rule(state.spec, [&sites, &size](std::string_view pattern, std::string_view value) {
+        bool valid;
+        if (parse_site(pattern, value, sites[size], valid) && valid) ++size;
+        return size < logovod::detail::sites::capacity;
+    });
+    logovod::detail::sites::assign(sites, sites + size);
+}
+} // namespace detail
+
+// Checks specification for errors without applying it
+inline bool validate(std::string_view spec) {
+    auto& state { detail::current() };
+    std::lock_guard<std::mutex> lock { state.mutex };
+    return detail::validate(state, spec);
+}
+
+// Registers a named sink for use in the configuration.
+// Members of the bundle that are nullptr are left unchanged when the sink is applied
+inline void add_sink(std::string_view name, sink::bundle bundle) {
+    auto& state { detail::current() };
+    std::lock_guard<std::mutex> lock { state.mutex };
+    for (auto& s : state.sinks) {
+        if (s.name == name) {
+            s.bundle = bundle;
+            return;
+        }
+    }
+    state.sinks.push_back({ std::string { name }, bundle });
+}
+
+// Name of a registered sink with the given writer, if any
+inline std::string sink_name(sink::bundle::writer_type writer) {
+    auto& state { detail::current() };
+    std::lock_guard<std::mutex> lock { state.mutex };
+    for (const auto& s : state.sinks) {
+        if (s.bundle.writer == writer) return s.name;
+    }
+    return {};
+}
+
+namespace detail {
+inline bool apply(state& state, std::string spec) {
+    if (!validate(state, spec)) return false;
+    state.spec = std::move(spec);
+    logovod::detail::registry::hook([](const logovod::detail::category_entry& entry) noexcept {
+        auto& active { current() };
+        std::lock_guard<std::mutex> lock { active.mutex };
+        apply_to(active, entry);
+    });
+    logovod::detail::registry::for_each([&state](const logovod::detail::category_entry& entry) {
+        apply_to(state, entry);
+    });
+    apply_sites(state);
+    return true;
+}
+} // namespace detail
+
+// Validates the specification, stores it and applies to all registered categories.
+// Returns false if the specification is malformed, in which case the configuration is not changed
+inline bool apply(std::string_view spec) {
+    auto& state { detail::current() };
+    std::lock_guard<std::mutex> lock { state.mutex };
+    return detail::apply(state, std::string { spec });
+}
+
+// Appends rules to the current specification, so that they take precedence over existing ones
+inline bool append(std::string_view rules) {
+    auto& state { detail::current() };
+    std::lock_guard<std::mutex> lock { state.mutex };
+    return detail::apply(state, state.spec + "\n" + std::string { rules });
+}
+
+// Currently applied specification
+inline std::string specification() {
+    auto& state { detail::current() };
+    std::lock_guard<std::mutex> lock { state.mutex };
+    return state.spec;
+}
+
+namespace detail {
+inline bool parse_number(std::string_view text, std::uint_least32_t& value) noexcept {
+    value = 0;
+    for (auto c : text) {
+        if (c < '0' || c > '9') return false;
+        value = value * 10 + static_cast<std::uint_least32_t>(c - '0');
+    }
+    return !text.empty();
+}
+
+// Compiles a filter rule - conditions tag=glob, file=glob, line=N or line=N-M, and the threshold level=L
+inline bool compile(std::string_view text, logovod::detail::filters::rule& rule) noexcept {
+    rule = {};
+    rule.last = std::numeric_limits<std::uint_least32_t>::max();
+    bool has_level {};
+    const auto valid = for_each_rule(text, [&rule, &has_level](std::string_view key, std::string_view value) {
+        if (key == "tag" && value.size() < sizeof(rule.tag)) {
+            value.copy(rule.tag, value.size());
+        } else if (key == "file" && value.size() < sizeof(rule.file)) {
+            value.copy(rule.file, value.size());
+        } else if (key == "line") {
+            const auto dash { value.find('-') };
+            if (!parse_number(value.substr(0, dash), rule.first)) return false;
+            if (dash == value.npos) rule.last = rule.first;
+            else if (!parse_number(value.substr(dash + 1), rule.last) || rule.last < rule.first) return false;
+        } else if (key == "level") {
+            const auto level { parse_level(value) };
+            if (value != "none" && level.kind != level_value::level) return false;
+            rule.level = value == "none" ? logovod::detail::filters::none : level.level;
+            has_level = true;
+        } else {
+            return false;
+        }
+        return true;
+    });
+    return valid && has_level;
+}
+} // namespace detail
+
+// Replaces filters of enabled statements. Rules are separated with semicolons or new lines,
+// the first rule, matching tag, file and line of a statement, gives its level threshold, e.g.
+// tag=net.* file=*/src/http/* level=debug; tag=net.* level=warning
+// Statements matching no rule pass. An empty specification removes all filters.
+// Returns false if the specification is malformed, in which case filters are not changed
+inline bool filter(std::string_view spec) {
+    logovod::detail::filters::rule rules[logovod::detail::filters::capacity];
+    std::size_t size {};
+    while (!spec.empty()) {
+        auto end { spec.find_first_of(";\n") };
+        if (end == spec.npos) end = spec.size();
+        auto text { spec.substr(0, end) };
+        spec.remove_prefix(end == spec.size() ? end : end + 1);
+        text = text.substr(0, text.find('#'));
+        if (text.find_first_not_of(" \t\r,") == text.npos) continue;
+        if (size == logovod::detail::filters::capacity || !detail::compile(text, rules[size++])) return false;
+    }
+    return logovod::detail::filters::assign(rules, rules + size);
+}
+
+// Loads configuration from the environment variable. Returns false if the variable is malformed
+inline bool load_env(const char* name = "LOGOVOD") {
+    const char* value { std::getenv(name) };
+    return value == nullptr || apply(value);
+}
+
+// Loads configuration from a file. Returns false if the file cannot be read or is malformed
+template<typename Path>
+bool load(const Path& path) {
+    std::ifstream file { path };
+    if (!file) return false;
+    const std::string spec { std::istreambuf_iterator<char>{file}, std::istreambuf_iterator<char>{} };
+    return !file.bad() && apply(spec);
+}
+
+} // namespace logovod::config
@@ -10,6 +10,12 @@
 #pragma once 
 #include <logovod/detail.h>
 #include <logovod/fixedbuf.h>
+#include <logovod/runtime.h>
+#include <logovod/spillbuf.h>
+#include <atomic>
+#include <algorithm>
+#include <charconv>
+#include <chrono>
 #include <cstdint>
 #include <string_view>
 #include <iostream>
@@ -29,6 +35,75 @@ enum class priority {
     debug
 };
 
+// Time sources for attributes and prologs. A source takes raw ticks on the hot path,
+// conversion to the wall time is deferred until the time stamp is rendered
+namespace clock {
+using sys_time = std::chrono::system_clock::time_point;
+
+// Raw ticks of a time source, with the function converting them to the wall time
+struct timestamp {
+    std::uint64_t ticks;
+    sys_time (*convert)(std::uint64_t) noexcept;
+    constexpr bool empty() const noexcept { return convert == nullptr; }
+    sys_time to_sys() const noexcept { return convert != nullptr ? convert(ticks) : sys_time {}; }
+};
+
+// No time stamps are taken
+struct none {
+    static constexpr timestamp now() noexcept { return {}; }
+};
+
+// std::chrono::system_clock, nanoseconds since the epoch
+struct system {
+    static std::uint64_t ticks() noexcept {
+        const auto now { std::chrono::system_clock::now().time_since_epoch() };
+        return static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(now).count());
+    }
+    static sys_time to_sys(std::uint64_t ticks) noexcept {
+        return sys_time { std::chrono::duration_cast<sys_time::duration>(std::chrono::nanoseconds { ticks }) };
+    }
+    static timestamp now() noexcept { return { ticks(), to_sys }; }
+};
+} // namespace clock
+
+// Mapped diagnostic context of the emitting thread, preformatted as space separated key=value pairs.
+// It refers to thread local storage and is valid only for the duration of a prolog, epilog or writer call
+class context_view {
+public:
+    // offsets of the '=' and of the end of an entry in the text
+    struct mark {
+        std::uint16_t equal;
+        std::uint16_t end;
+    };
+    constexpr context_view() noexcept = default;
+    constexpr context_view(std::string_view text, const mark* marks, std::size_t size) noexcept
+      : text_ { text }, marks_ { marks }, size_ { size } {}
+    constexpr std::string_view text() const noexcept { return text_; }
+    constexpr std::size_t size() const noexcept { return size_; }
+    constexpr bool empty() const noexcept { return size_ == 0; }
+    // Calls function(key, value) for each entry, the outermost first
+    template<typename Function>
+    constexpr void for_each(Function&& function) const {
+        for (std::size_t i = 0; i < size_; ++i) function(key(i), value(i));
+    }
+    // Value of the innermost entry with the given key, empty if none
+    constexpr std::string_view find(std::string_view name) const noexcept {
+        for (auto i { size_ }; i-- != 0; ) if (key(i) == name) return value(i);
+        return {};
+    }
+private:
+    constexpr std::size_t begin(std::size_t i) const noexcept { return i == 0 ? 0 : marks_[i - 1].end + 1u; }
+    constexpr std::string_view key(std::size_t i) const noexcept {
+        return text_.substr(begin(i), marks_[i].equal - begin(i));
+    }
+    constexpr std::string_view value(std::size_t i) const noexcept {
+        return text_.substr(marks_[i].equal + 1u, marks_[i].end - marks_[i].equal - 1u);
+    }
+    std::string_view text_ {};
+    const mark* marks_ {};
+    std::size_t size_ {};
+};
+
 struct attributes {
     struct source_location {
         std::string_view file_name;
@@ -37,6 +112,14 @@ struct attributes {
     priority level;
     std::string_view tag;
     source_location location;
+    context_view context {};
+    // captured once per message, when formatting starts
+    clock::timestamp time {};
+    std::uint32_t thread {};
+    std::uint64_t sequence {};
+    // records of a message written in parts share the sequence number, more parts follow those continued
+    std::uint32_t part {};
+    bool continued {};
 };
 
 template<typename CharT, class Traits = std::char_traits<CharT>>
@@ -56,6 +139,21 @@ struct basic_sink_types {
 namespace sink {
 using bundle = basic_sink_types<char>;
 
+namespace detail {
+template<typename Writer>
+struct writer_traits;
+
+template<typename CharT, class Traits>
+struct writer_traits<void(*)(std::basic_string_view<CharT, Traits>, std::basic_string_view<CharT, Traits>, attributes) noexcept> {
+    using string_view = std::basic_string_view<CharT, Traits>;
+    using char_type = CharT;
+};
+
+// String view type of a writer, used by writer adapters
+template<auto Writer>
+using writer_string_view = typename writer_traits<decltype(Writer)>::string_view;
+} // namespace detail
+
 // write to a predefined file descriptor, such as 1 or 2
 template<int FD>
 void fd(std::string_view message, std::string_view payload, attributes) noexcept;
@@ -124,11 +222,21 @@ struct category {
     using char_type = char;
     using char_traits = std::char_traits<char>;
     using sink_types = basic_sink_types<char_type, char_traits>;
+    // Time source of attributes::time, e.g. clock::system
+    using clock_type = clock::none;
     // Always constexpr properties
     // Category tag, passed to prolog and epilog via attributes
     static constexpr std::string_view tag = "";
     // Message length limit (buffer size)
     static constexpr std::size_t length_limit = 1024; // set to unlimited for no limit
+    // Hard limit of messages spilled to the thread-local arena, when they do not fit length_limit, 0 for none
+    static constexpr std::size_t spill_limit = 0;
+    // Messages not fitting length_limit are written in parts instead of being truncated, see attributes::part
+    static constexpr bool chunked = false;
+    // Statements below the level are enabled by level_scope on the current thread
+    static constexpr bool elevatable = false;
+    // Statements below the level are enabled by call site rules, see config::apply
+    static constexpr bool overridable = false;
     // Properties that can be changed from constexpr or dynamic/run-time
     static constexpr priority level() noexcept { return priority::debug; }
     static constexpr sink_types::writer_type writer() noexcept { return sink::clog; }
@@ -140,7 +248,11 @@ struct category {
     static constexpr separators sep() noexcept { return consts::default_separators; }
     // Limits number of printed container elements
     static constexpr std::size_t range_limit() noexcept { return 16; }
-    // Indication of trimmed container printing imposed by range_limit()
+    // Limits total number of printed elements of all containers in a message, nested ones included
+    static constexpr std::size_t element_limit() noexcept { return unlimited; }
+    // Stops printing of values, when the message reaches the length, useful with unlimited length_limit
+    static constexpr std::size_t byte_limit() noexcept { return unlimited; }
+    // Indication of trimmed printing imposed by range_limit(), element_limit() or byte_limit()
     static constexpr std::string_view trimmed() noexcept { return "..."; }
 };
 
@@ -148,11 +260,21 @@ struct wcategory {
     using char_type = wchar_t;
     using char_traits = std::char_traits<wchar_t>;
     using sink_types = basic_sink_types<char_type, char_traits>;
+    // Time source of attributes::time, e.g. clock::system
+    using clock_type = clock::none;
     // Always constexpr properties
     // Category tag, passed to prolog and epilog via attributes. Not wstring_view by intent
     static constexpr std::string_view tag = "";
     // Message length limit (buffer size)
     static constexpr std::size_t length_limit = 1024; // set to unlimited for no limit
+    // Hard limit of messages spilled to the thread-local arena, when they do not fit length_limit, 0 for none
+    static constexpr std::size_t spill_limit = 0;
+    // Messages not fitting length_limit are written in parts instead of being truncated, see attributes::part
+    static constexpr bool chunked = false;
+    // Statements below the level are enabled by level_scope on the current thread
+    static constexpr bool elevatable = false;
+    // Statements below the level are enabled by call site rules, see config::apply
+    static constexpr bool overridable = false;
     // Properties that can be changed from constexpr or dynamic/run-time
     static constexpr priority level() noexcept { return priority::debug; }
     static constexpr sink_types::writer_type writer() noexcept { return sink::wclog; }
@@ -164,11 +286,344 @@ struct wcategory {
     static constexpr wseparators sep() noexcept { return wseparators {L'{', L',', L'}'}; }
     // Limits number of printed container elements
     static constexpr std::size_t range_limit() noexcept { return 16; }
-    // Indication of trimmed container printing imposed by range_limit()
+    // Limits total number of printed elements of all containers in a message, nested ones included
+    static constexpr std::size_t element_limit() noexcept { return unlimited; }
+    // Stops printing of values, when the message reaches the length in characters
+    static constexpr std::size_t byte_limit() noexcept { return unlimited; }
+    // Indication of trimmed printing imposed by range_limit(), element_limit() or byte_limit()
     static constexpr std::wstring_view trimmed() noexcept { return L"..."; }
 };
 
 
+namespace detail {
+// Per call site metrics, defined in <logovod/metric.h>
+template<class Category>
+class metrics;
+
+// Matches text against a pattern with wildcards * and ?
+inline bool glob_match(std::string_view pattern, std::string_view text) noexcept {
+    std::size_t p {}, t {};
+    auto star { std::string_view::npos };
+    std::size_t mark {};
+    while (t < text.size()) {
+        if (p < pattern.size() && (pattern[p] == '?' || pattern[p] == text[t])) {
+            ++p; ++t;
+        } else if (p < pattern.size() && pattern[p] == '*') {
+            star = p++;
+            mark = t;
+        } else if (star != std::string_view::npos) {
+            p = star + 1;
+            t = ++mark;
+        } else {
+            return false;
+        }
+    }
+    while (p < pattern.size() && pattern[p] == '*') ++p;
+    return p == pattern.size();
+}
+
+// Per call site level overrides, that enable statements below the level of their categories.
+// Checked only for disabled statements and only when there are overrides
+class sites {
+public:
+    struct rule {
+        static constexpr std::size_t file_size = 128;
+        // file name or its trailing part, zero terminated
+        char file[file_size];
+        std::uint_least32_t line;
+        priority level;
+    };
+    static constexpr std::size_t capacity = 32;
+
+    static bool active() noexcept { return size_.load(std::memory_order_relaxed) != 0; }
+    // The most verbose level of the overrides, statements above it are not enabled by overrides
+    static priority gate() noexcept { return gate_.load(std::memory_order_relaxed); }
+    static bool enabled(priority p, const source_location& sl) noexcept {
+        const epoch::guard guard { epoch_ };
+        const auto& set { sets_[current_.load(std::memory_order_acquire)] };
+        const auto line { sl.line() };
+        for (std::size_t i = 0; i < set.size; ++i) {
+            const auto& r { set.rules[i] };
+            if (r.line == line && p <= r.level && matches(r.file, sl.file_name())) return true;
+        }
+        return false;
+    }
+    // Replaces all overrides, returns false if there are too many of them
+    static bool assign(const rule* begin, const rule* end) noexcept {
+        const auto size { static_cast<std::size_t>(end - begin) };
+        if (size > capacity) return false;
+        std::lock_guard<std::mutex> lock { mutex_ };
+        const auto next { current_.load(std::memory_order_relaxed) ^ 1u };
+        // readers of the inactive set are done since the previous assign synchronized
+        std::copy(begin, end, sets_[next].rules);
+        sets_[next].size = size;
+        current_.store(next, std::memory_order_release);
+        size_.store(size, std::memory_order_relaxed);
+        auto gate { none };
+        for (auto r { begin }; r != end; ++r) if (gate < r->level) gate = r->level;
+        gate_.store(gate, std::memory_order_relaxed);
+        epoch_.synchronize();
+        return true;
+    }
+    static std::size_t size() noexcept { return size_.load(std::memory_order_relaxed); }
+    static constexpr auto none = static_cast<priority>(-1);
+    static bool matches(std::string_view pattern, std::string_view file) noexcept {
+        if (pattern.empty() || file.size() < pattern.size() || file.substr(file.size() - pattern.size()) != pattern) return false;
+        return file.size() == pattern.size() || pattern.front() == '/' || file[file.size() - pattern.size() - 1] == '/';
+    }
+private:
+    struct set {
+        rule rules[capacity];
+        std::size_t size;
+    };
+    static bool matches(const char* pattern, const char* file) noexcept {
+        return file != nullptr && matches(std::string_view { pattern }, std::string_view { file });
+    }
+    static inline set sets_[2] {};
+    static inline std::atomic<unsigned> current_ {};
+    static inline std::atomic<std::size_t> size_ {};
+    static inline std::atomic<priority> gate_ { none };
+    static inline epoch epoch_ {};
+    static inline std::mutex mutex_ {};
+};
+
+// Thread local level elevation, enabling statements of elevatable categories up to the level on the current thread
+class elevation {
+public:
+    static constexpr auto none = static_cast<priority>(-1);
+    static priority level() noexcept { return level_; }
+    static priority exchange(priority value) noexcept {
+        const auto previous { level_ };
+        level_ = value;
+        return previous;
+    }
+private:
+    static inline thread_local priority level_ { none };
+};
+
+// Filter over attributes of enabled statements, narrowing levels of categories per tag, file and line.
+// The first matching rule gives the level threshold for the call site, call sites matching no rule pass.
+// Decisions are cached per thread and call site, so that the rules are evaluated once per site and change
+class filters {
+public:
+    struct rule {
+        // tag and file patterns with wildcards, zero terminated, empty matches any
+        char tag[64];
+        char file[128];
+        std::uint_least32_t first;
+        std::uint_least32_t last;
+        // statements above the threshold are rejected, none rejects all
+        priority level;
+    };
+    static constexpr std::size_t capacity = 32;
+    static constexpr auto none = static_cast<priority>(-1);
+
+    static bool active() noexcept { return size_.load(std::memory_order_relaxed) != 0; }
+    static bool pass(std::string_view tag, priority p, const source_location& sl) noexcept {
+        const auto file { sl.file_name() };
+        const auto line { sl.line() };
+        const auto key { reinterpret_cast<std::uintptr_t>(file) ^ reinterpret_cast<std::uintptr_t>(tag.data()) ^ line * 0x9E3779B1u };
+        auto& cached { cache_[(key ^ (key >> 12)) % cache_size] };
+        const auto gen { generation_.load(std::memory_order_acquire) };
+        if (cached.generation != gen || cached.file != file || cached.line != line || cached.tag != tag.data()) {
+            cached = { file, tag.data(), line, gen, evaluate(tag, file, line) };
+        }
+        return p <= cached.level;
+    }
+    // Replaces all rules, returns false if there are too many of them
+    static bool assign(const rule* begin, const rule* end) noexcept {
+        const auto size { static_cast<std::size_t>(end - begin) };
+        if (size > capacity) return false;
+        std::lock_guard<std::mutex> lock { mutex_ };
+        const auto next { current_.load(std::memory_order_relaxed) ^ 1u };
+        std::copy(begin, end, sets_[next].rules);
+        sets_[next].size = size;
+        current_.store(next, std::memory_order_release);
+        generation_.fetch_add(1, std::memory_order_release);
+        size_.store(size, std::memory_order_relaxed);
+        epoch_.synchronize();
+        return true;
+    }
+    static std::size_t size() noexcept { return size_.load(std::memory_order_relaxed); }
+private:
+    static priority evaluate(std::string_view tag, const char* file, std::uint_least32_t line) noexcept {
+        const epoch::guard guard { epoch_ };
+        const auto& set { sets_[current_.load(std::memory_order_acquire)] };
+        const std::string_view name { file != nullptr ? file : "" };
+        for (std::size_t i = 0; i < set.size; ++i) {
+            const auto& r { set.rules[i] };
+            if (line >= r.first && line <= r.last && (r.tag[0] == '\0' || glob_match(r.tag, tag))
+                && (r.file[0] == '\0' || glob_match(r.file, name))) return r.level;
+        }
+        return priority::debug;
+    }
+    struct set {
+        rule rules[capacity];
+        std::size_t size;
+    };
+    struct decision {
+        const char* file;
+        const char* tag;
+        std::uint_least32_t line;
+        std::uint64_t generation;
+        priority level;
+    };
+    static constexpr std::size_t cache_size = 64;
+    static inline set sets_[2] {};
+    static inline std::atomic<unsigned> current_ {};
+    static inline std::atomic<std::size_t> size_ {};
+    static inline std::atomic<std::uint64_t> generation_ { 1 };
+    static inline thread_local decision cache_[cache_size] {};
+    static inline epoch epoch_ {};
+    static inline std::mutex mutex_ {};
+};
+
+// Per thread ring of the last Category::backlog() messages, that were not written
+template<class Category>
+class backlog {
+public:
+    using char_type = typename Category::char_type;
+    using string_view = std::basic_string_view<char_type, typename Category::char_traits>;
+    static constexpr std::size_t capacity = Category::backlog();
+    // longer messages are truncated
+    static constexpr std::size_t record_size = 256;
+    static void push(string_view message, string_view payload, attributes attrs) noexcept {
+        auto& r { ring_.records[ring_.next++ % capacity] };
+        r.attrs = attrs;
+        r.attrs.context = {}; // the context is rendered in the message, if at all
+        r.size = message.copy(r.text, record_size);
+        r.payload_begin = std::min(static_cast<std::size_t>(payload.data() - message.data()), r.size);
+        r.payload_end = std::min(r.payload_begin + payload.size(), r.size);
+        if (ring_.size < capacity) ++ring_.size;
+    }
+    // Writes captured messages, the oldest first, and clears the ring
+    template<typename Writer>
+    static void dump(Writer&& writer) noexcept {
+        for (auto i { ring_.next - ring_.size }; i != ring_.next; ++i) {
+            const auto& r { ring_.records[i % capacity] };
+            const string_view message { r.text, r.size };
+            writer(message, message.substr(r.payload_begin, r.payload_end - r.payload_begin), r.attrs);
+        }
+        ring_.size = 0;
+    }
+    static std::size_t size() noexcept { return ring_.size; }
+private:
+    struct record {
+        attributes attrs;
+        std::size_t size;
+        std::size_t payload_begin;
+        std::size_t payload_end;
+        char_type text[record_size];
+    };
+    struct ring {
+        record records[capacity];
+        std::size_t next;
+        std::size_t size;
+    };
+    static inline thread_local ring ring_ {};
+};
+
+// Thread local mapped diagnostic context. Entries are formatted once, when pushed,
+// and copied to messages as a single preformatted text
+class context {
+public:
+    static constexpr std::size_t capacity = 16;
+    static constexpr std::size_t text_size = 512;
+    struct state {
+        char text[text_size];
+        context_view::mark marks[capacity];
+        std::size_t size;
+    };
+    static context_view view() noexcept {
+        return { { state_.text, length(state_) }, state_.marks, state_.size };
+    }
+    // Returns false, leaving the context intact, if the entry does not fit
+    static bool push(std::string_view key, std::string_view value) noexcept {
+        auto pos { length(state_) };
+        const auto size { key.size() + value.size() + (state_.size == 0 ? 1 : 2) };
+        if (state_.size == capacity || pos + size > text_size) return false;
+        if (state_.size != 0) state_.text[pos++] = ' ';
+        pos += key.copy(state_.text + pos, key.size());
+        const auto equal { pos };
+        state_.text[pos++] = '=';
+        pos += value.copy(state_.text + pos, value.size());
+        state_.marks[state_.size++] = { static_cast<std::uint16_t>(equal), static_cast<std::uint16_t>(pos) };
+        return true;
+    }
+    // Pushes entries of a captured context, those that fit
+    static void push(const state& captured) noexcept {
+        const context_view entries { { captured.text, length(captured) }, captured.marks, captured.size };
+        entries.for_each([](std::string_view key, std::string_view value) { push(key, value); });
+    }
+    // Removes entries above the given size
+    static void truncate(std::size_t size) noexcept {
+        state_.size = std::min(size, state_.size);
+    }
+    static std::size_t size() noexcept { return state_.size; }
+    static const state& current() noexcept { return state_; }
+private:
+    static std::size_t length(const state& s) noexcept {
+        return s.size == 0 ? 0 : s.marks[s.size - 1].end;
+    }
+    static inline thread_local state state_ {};
+};
+} // namespace detail
+
+// Scoped entry of the mapped diagnostic context, e.g. a request id, made available to prologs and sinks.
+// The context may be captured and restored in another thread, to follow the request across asynchronous tasks:
+// auto captured { context_scope::capture() }; ... context_scope scope { captured };
+class context_scope {
+public:
+    struct snapshot {
+        detail::context::state state;
+    };
+    // The entry is silently dropped if the context is full
+    template<typename T>
+    context_scope(std::string_view key, const T& value) noexcept : size_ { detail::context::size() } {
+        if constexpr (std::is_convertible_v<const T&, std::string_view>) {
+            detail::context::push(key, value);
+        } else if constexpr (std::is_same_v<T, bool>) {
+            detail::context::push(key, value ? "true" : "false");
+        } else {
+            static_assert(std::is_arithmetic_v<T>, "context values are strings or numbers");
+            char text[32];
+            const auto result { std::to_chars(std::begin(text), std::end(text), +value) };
+            detail::context::push(key, { text, static_cast<std::size_t>(result.ptr - text) });
+        }
+    }
+    explicit context_scope(const snapshot& captured) noexcept : size_ { detail::context::size() } {
+        detail::context::push(captured.state);
+    }
+    context_scope(const context_scope&) = delete;
+    context_scope(context_scope&&) = delete;
+    context_scope& operator=(const context_scope&) = delete;
+    context_scope& operator=(context_scope&&) = delete;
+    ~context_scope() { detail::context::truncate(size_); }
+    static snapshot capture() noexcept { return { detail::context::current() }; }
+private:
+    std::size_t size_;
+};
+
+// Elevates levels of elevatable categories on the current thread for the life time of the scope, e.g. to trace a request.
+// The elevation may be captured and restored in another thread, to follow the request across asynchronous tasks:
+// auto captured { level_scope::capture() }; ... level_scope scope { captured };
+class level_scope {
+public:
+    struct snapshot {
+        priority level;
+    };
+    explicit level_scope(priority level) noexcept : previous_ { detail::elevation::exchange(level) } {}
+    explicit level_scope(snapshot captured) noexcept : level_scope { captured.level } {}
+    level_scope(const level_scope&) = delete;
+    level_scope(level_scope&&) = delete;
+    level_scope& operator=(const level_scope&) = delete;
+    level_scope& operator=(level_scope&&) = delete;
+    ~level_scope() { detail::elevation::exchange(previous_); }
+    static snapshot capture() noexcept { return { detail::elevation::level() }; }
+private:
+    priority previous_;
+};
+
 template<class Category>
 class logger {
 public:
@@ -180,8 +635,8 @@ public:
 
     class basic_emitter {
     protected:
-        constexpr basic_emitter(source_location&& sl) noexcept : location_ { std::move(sl) } {}
-        constexpr basic_emitter(const source_location& sl) noexcept : location_ { sl } {}
+        constexpr basic_emitter(source_location&& sl) noexcept : location_ { std::move(sl) } { chain(); }
+        constexpr basic_emitter(const source_location& sl) noexcept : location_ { sl } { chain(); }
         basic_emitter(const basic_emitter&) = delete;
         basic_emitter(basic_emitter&&) = delete;
         basic_emitter& operator=(const basic_emitter&) = delete;
@@ -189,6 +644,14 @@ public:
         ~basic_emitter() = default;
         template<typename ... T>
         void operator()(const T &... val) {
+            if constexpr (category_type::length_limit != unlimited && printer::template direct<T...>()) {
+                // statements of bounded length are written directly, if the buffer has space for them
+                const auto pos { buffer_.reserve(printer::template max_size<T...>()) };
+                if (pos != nullptr && !printer_.exhausted(stream_) && printer::template plain<T...>(stream_)) {
+                    buffer_.commit(printer_.direct(pos, val...));
+                    return;
+                }
+            }
             printer_(stream_, val ...);
         }
         template<typename T>
@@ -210,24 +673,44 @@ public:
 #if defined(__cpp_lib_format)
         template<typename ... T>
         void format(std::basic_format_string<char_type, std::type_identity_t<T>...> fmt, T&&... args) {
-            if constexpr(category_type::length_limit == unlimited) {
+            if constexpr(category_type::length_limit == unlimited || category_type::chunked) {
                 std::format_to(std::ostreambuf_iterator<char_type, char_traits>{&buffer_}, fmt, args...);
             } else {
                 std::format_to_n(std::ostreambuf_iterator<char_type, char_traits>{&buffer_}, buffer_.available(), fmt, std::forward<T>(args)...);
             }
         }
 #endif
-        void prolog(attributes attrs) {
+        // Returns false if the message is suppressed by the category limiter
+        bool prolog(attributes attrs) {
             if (!prolog_done_) {
+                if (suppressed_) return false;
                 if (epilog_done_) reset();
-                category_type::prolog()(stream_, attrs);
+                if constexpr (detail::has_limiter_v<category_type>) {
+                    const auto decision { category_type::limiter().template admit<category_type>(location_) };
+                    if (!decision.admitted) {
+                        detail::counters::add(detail::counter::suppressed);
+                        suppressed_ = true;
+                        return false;
+                    }
+                    reported_ = decision.suppressed;
+                }
+                time_ = category_type::clock_type::now();
+                sequence_ = detail::sequence::next();
+                level_ = attrs.level;
+                const detail::sink_guard<category_type> guard { pinned_ };
+                category_type::prolog()(stream_, stamped(attrs));
                 payload_begin_ = tellp();
                 prolog_done_ = true;
             }
+            return true;
         }
         void epilog(attributes attrs) {
             if (!epilog_done_) {
                 payload_end_ = tellp();
+                if constexpr (detail::has_limiter_v<category_type>) {
+                    // messages suppressed at the call site since the previous admitted one
+                    if (reported_ != 0) stream_ << " [" << reported_ << " suppressed]";
+                }
                 // functors are allowed to use epilog that returns void
                 if constexpr(std::is_void_v<decltype(category_type::epilog()(attrs, stream_))>) {
                     category_type::epilog()(attrs, stream_);
@@ -237,27 +720,119 @@ public:
                 epilog_done_ = true;
             }
         }
+        // Statements within the category level pass filters, if any,
+        // statements below the level are enabled by the thread elevation or call site overrides, if any
+        static bool writable(priority p, const source_location& sl) noexcept {
+            if (p <= category_type::level()) return !detail::filters::active() || detail::filters::pass(category_type::tag, p, sl);
+            if constexpr (category_type::elevatable) {
+                if (p <= detail::elevation::level()) return true;
+            }
+            if constexpr (category_type::overridable) {
+                // the only branch taken on the common path, with no call site overrides
+                return p <= detail::sites::gate() && detail::sites::enabled(p, sl);
+            } else {
+                return false;
+            }
+        }
+        // Statements above the constexpr level of categories, not enabled otherwise, are compiled out
+        static constexpr bool discarded(priority p) noexcept {
+            if constexpr (detail::has_constexpr_level_v<category_type> && !detail::has_backlog_v<category_type> &&
+                          !category_type::elevatable && !category_type::overridable) {
+                return p > category_type::level();
+            } else {
+                return false;
+            }
+        }
+        // Statements of categories with a backlog are always formatted, those not writable are captured
+        static bool enabled(priority p, const source_location& sl) noexcept {
+            if constexpr (detail::has_backlog_v<category_type>) {
+                return true;
+            } else {
+                return writable(p, sl);
+            }
+        }
+        bool enabled(priority p) const noexcept {
+            return enabled(p, location_);
+        }
         attributes make_attrs(priority p) const noexcept {
-            return {p, category_type::tag, {location_.file_name(), location_.line()}};
+            return {p, category_type::tag, {location_.file_name(), location_.line()}, detail::context::view(),
+                    time_, detail::thread_number(), sequence_};
+        }
+        // Attributes made before the prolog get the time stamp and the sequence number taken by it
+        attributes stamped(attributes attrs) const noexcept {
+            attrs.time = time_;
+            attrs.sequence = sequence_;
+            attrs.part = part_;
+            return attrs;
+        }
+        void chain() noexcept {
+            if constexpr (category_type::chunked) {
+                buffer_.handler([](void* self) { return static_cast<basic_emitter*>(self)->chunk(); }, this);
+            }
+        }
+        // Writes the full buffer as a continued part of the message and starts the next part with the prolog
+        bool chunk() noexcept {
+            if (!prolog_done_ || epilog_done_) return false;
+            auto attrs { stamped(make_attrs(level_)) };
+            attrs.continued = true;
+            buffer_.extend();
+            {
+                const detail::sink_guard<category_type> guard { pinned_ };
+                epilog(attrs);
+                write(buffer_.view(), attrs);
+            }
+            buffer_.pubseekpos(0);
+            ++part_;
+            const detail::sink_guard<category_type> guard { pinned_ };
+            // a prolog overflowing the buffer is truncated, as epilog_done_ is still set
+            category_type::prolog()(stream_, stamped(attrs));
+            payload_begin_ = tellp();
+            epilog_done_ = false;
+            return true;
         }
         void flush(attributes attrs) {
+            if (suppressed_) {
+                suppressed_ = false;
+                return;
+            }
+            const detail::sink_guard<category_type> guard { pinned_ };
+            if (!epilog_done_ && (stream_.fail() || printer_.spent())) detail::counters::add(detail::counter::truncated);
+            attrs = stamped(attrs);
+            if constexpr (category_type::chunked) buffer_.extend();
             epilog(attrs);
             if constexpr (detail::has_view_v<buffer_type>) {
-                const auto message = buffer_.view();
-                const auto payload = message.substr(static_cast<std::size_t>(payload_begin_), static_cast<std::size_t>(payload_end_ - payload_begin_));
-                category_type::writer()(message, payload, attrs);
+                write(buffer_.view(), attrs);
             } else {
                 const auto str = buffer_.str();
-                const auto message { str };
-                const auto payload = message.substr(static_cast<std::size_t>(payload_begin_), static_cast<std::size_t>(payload_end_ - payload_begin_));
-                category_type::writer()(message, payload, attrs);
+                write(str, attrs);
             }
             prolog_done_ = false;
         }
+        void write(std::basic_string_view<char_type, char_traits> message, attributes attrs) {
+            const auto payload = message.substr(static_cast<std::size_t>(payload_begin_), static_cast<std::size_t>(payload_end_ - payload_begin_));
+            if constexpr (detail::has_backlog_v<category_type>) {
+                if (!writable(attrs.level, location_)) {
+                    detail::backlog<category_type>::push(message, payload, attrs);
+                    return;
+                }
+                // the backlog gives the context of the failure, dumped messages are accounted as written ones
+                if (attrs.level <= priority::error) detail::backlog<category_type>::dump(deliver);
+            }
+            deliver(message, payload, attrs);
+        }
+        // Writes the message with the category writer and accounts it in the counters
+        static void deliver(std::basic_string_view<char_type, char_traits> message,
+                            std::basic_string_view<char_type, char_traits> payload, attributes attrs) {
+            category_type::writer()(message, payload, attrs);
+            detail::counters::add(detail::counter::bytes, message.size());
+            detail::counters::add(detail::counter::messages);
+        }
         void reset() {
             buffer_.pubseekpos(0);
             prolog_done_ = false;
             epilog_done_ = false;
+            suppressed_ = false;
+            part_ = 0;
             location_ = source_location { };
             printer_.reset(category_type::dlm(), category_type::sep());
             stream_.clear();
@@ -266,7 +841,11 @@ public:
             stream_.precision(fmtstate_.precision_); // TODO consider removing
         }
         using buffer_type = typename std::conditional<category_type::length_limit == unlimited,
-        std::basic_stringbuf<char_type, char_traits>, detail::basic_fixedbuf<category_type::length_limit, char_type, char_traits>>::type;
+        std::basic_stringbuf<char_type, char_traits>, typename std::conditional<category_type::chunked,
+        detail::basic_chunkbuf<category_type::length_limit, char_type, char_traits>,
+        typename std::conditional<(category_type::spill_limit > category_type::length_limit),
+        detail::basic_spillbuf<category_type::length_limit, category_type::spill_limit, char_type, char_traits>,
+        detail::basic_fixedbuf<category_type::length_limit, char_type, char_traits>>::type>::type>::type;
         using pos_type = typename buffer_type::pos_type;
         buffer_type buffer_ { };
         std::basic_ostream<char_type, char_traits> stream_ { &buffer_ };
@@ -275,12 +854,21 @@ public:
             std::streamsize precision_;
             std::ios_base::fmtflags flags_;
         } fmtstate_ { stream_.width(), stream_.precision(), stream_.flags() };
-        printer printer_ { category_type::range_limit(), category_type::trimmed(), category_type::dlm(), category_type::sep() };
+        printer printer_ { category_type::range_limit(), category_type::trimmed(), category_type::dlm(), category_type::sep(),
+                           category_type::element_limit(), category_type::byte_limit() };
         source_location location_ { };
         pos_type payload_begin_ { };
         pos_type payload_end_ { };
+        std::uint64_t reported_ { };
+        clock::timestamp time_ { };
+        std::uint64_t sequence_ { };
+        std::uint32_t part_ { };
+        priority level_ { };
         bool prolog_done_ { };
         bool epilog_done_ { };
+        // the category epoch is pinned by the statement
+        bool pinned_ { };
+        bool suppressed_ { };
     };
 
     template<priority Priority>
@@ -298,51 +886,56 @@ public:
         emitter& operator=(const emitter&) = delete;
         emitter& operator=(emitter&&) = delete;
         ~emitter() { if (basic_emitter::prolog_done_) flush(); }
-        constexpr operator bool() const noexcept { return Priority <= category_type::level(); }
+        constexpr operator bool() const noexcept {
+            if constexpr (discarded) { return false; } else { return enabled(); }
+        }
+        // Whether a statement at the call site would be written, without constructing an emitter
+        static bool enabled_at(const source_location& sl) noexcept {
+            if constexpr (discarded) { return false; } else { return basic_emitter::enabled(Priority, sl); }
+        }
 
         template<typename ... T>
         void operator()(const T &... val) {
-            if (Priority <= category_type::level()) {
+            if (enabled()) {
+                const detail::sink_guard<category_type> guard { basic_emitter::pinned_ };
                 const auto attrs { make_attrs(Priority) };
-                prolog(attrs);
-                basic_emitter::operator()(val...);
+                if (prolog(attrs)) basic_emitter::operator()(val...);
                 flush(attrs);
             }
         }
         template<typename ... T>
         void operator()(source_location &&sl, const T &... val) {
-            if (Priority <= category_type::level()) {
+            if (enabled(sl)) {
                 basic_emitter::location_ = std::move(sl);
                 if constexpr(sizeof...(T) != 0) {
+                    const detail::sink_guard<category_type> guard { basic_emitter::pinned_ };
                     const auto attrs { make_attrs(Priority) };
-                    prolog(attrs);
-                    basic_emitter::operator()(val...);
+                    if (prolog(attrs)) basic_emitter::operator()(val...);
                     flush(attrs);
                 }
             }
         }
         template<typename ... T>
         void operator()(const source_location &sl, const T &... val) {
-            if (Priority <= category_type::level()) {
+            if (enabled(sl)) {
                 basic_emitter::location_ = sl;
                 if constexpr (sizeof...(T) != 0) {
+                    const detail::sink_guard<category_type> guard { basic_emitter::pinned_ };
                     const auto attrs { make_attrs(Priority) };
-                    prolog(attrs);
-                    basic_emitter::operator()(val...);
+                    if (prolog(attrs)) basic_emitter::operator()(val...);
                     flush(attrs);
                 }
             }
         }
         template<typename T>
         emitter& operator<<(const T &value) {
-            if (Priority <= category_type::level()) {
-                prolog(make_attrs(Priority));
-                basic_emitter::operator<<(value);
+            if (enabled()) {
+                if (prolog(make_attrs(Priority))) basic_emitter::operator<<(value);
             }
             return *this;
         }
         emitter& operator<<(ostream& (*f)(ostream&)) {
-            if (Priority <= category_type::level()) {
+            if (enabled()) {
                 const auto attrs { make_attrs(Priority) };
                 prolog(attrs);
                 static constexpr ostream& (*el)(ostream&) = &std::endl;
@@ -352,7 +945,7 @@ public:
             return *this;
         }
         emitter& flush() {
-            if (Priority <= category_type::level()) {
+            if (enabled()) {
                 flush(make_attrs(Priority));
             }
             return *this;
@@ -360,18 +953,26 @@ public:
 #if defined(__cpp_lib_format)
         template<typename ... T>
         void format(std::basic_format_string<char_type, std::type_identity_t<T>...> fmt, T&&... args) {
-            if (Priority <= category_type::level()) {
+            if (enabled()) {
+                const detail::sink_guard<category_type> guard { basic_emitter::pinned_ };
                 const auto attrs { make_attrs(Priority) };
-                prolog(attrs);
-                basic_emitter::format(fmt, std::forward<T>(args)...);
+                if (prolog(attrs)) basic_emitter::format(fmt, std::forward<T>(args)...);
                 flush(attrs);
             }
         }
 #endif
     private:
+        static constexpr bool discarded = basic_emitter::discarded(Priority);
+        bool enabled() const noexcept {
+            if constexpr (discarded) { return false; } else { return basic_emitter::enabled(Priority); }
+        }
+        bool enabled(const source_location& sl) const noexcept {
+            if constexpr (discarded) { return false; } else { return basic_emitter::enabled(Priority, sl); }
+        }
         using basic_emitter::flush;
         using basic_emitter::prolog;
         using basic_emitter::make_attrs;
+        using basic_emitter::enabled;
     };
     class log : basic_emitter {
     public:
@@ -391,50 +992,49 @@ public:
         void operator()(priority p) noexcept {
             priority_ = p;
         }
-        operator bool() const noexcept { return priority_ <= category_type::level(); }
+        operator bool() const noexcept { return enabled(priority_); }
         template<typename ... T>
         void operator()(const T &... val) {
-            if (priority_ <= category_type::level()) {
+            if (enabled(priority_)) {
+                const detail::sink_guard<category_type> guard { basic_emitter::pinned_ };
                 const auto attrs { make_attrs(priority_) };
-                prolog(attrs);
-                basic_emitter::operator()(val...);
+                if (prolog(attrs)) basic_emitter::operator()(val...);
                 flush(attrs);
             }
         }
         template<typename ... T>
         void operator()(source_location &&sl, const T &... val) {
-            if (priority_ <= category_type::level()) {
+            if (enabled(priority_, sl)) {
                 basic_emitter::location_ = std::move(sl);
                 if constexpr (sizeof...(T) != 0) {
+                    const detail::sink_guard<category_type> guard { basic_emitter::pinned_ };
                     const auto attrs { make_attrs(priority_) };
-                    prolog(attrs);
-                    basic_emitter::operator()(val...);
+                    if (prolog(attrs)) basic_emitter::operator()(val...);
                     flush(attrs);
                 }
             }
         }
         template<typename ... T>
         void operator()(const source_location &sl, const T &... val) {
-            if (priority_ <= category_type::level()) {
+            if (enabled(priority_, sl)) {
                 basic_emitter::location_ = sl;
                 if constexpr (sizeof...(T) != 0) {
+                    const detail::sink_guard<category_type> guard { basic_emitter::pinned_ };
                     const auto attrs { make_attrs(priority_) };
-                    prolog(attrs);
-                    basic_emitter::operator()(val...);
+                    if (prolog(attrs)) basic_emitter::operator()(val...);
                     flush(attrs);
                 }
             }
         }
         template<typename T>
         log& operator<<(const T &value) {
-            if (priority_ <= category_type::level()) {
-                prolog(make_attrs(priority_));
-                basic_emitter::operator<<(value);
+            if (enabled(priority_)) {
+                if (prolog(make_attrs(priority_))) basic_emitter::operator<<(value);
             }
             return *this;
         }
         log& operator<<(ostream& (*f)(ostream&)) {
-            if (priority_ <= category_type::level()) {
+            if (enabled(priority_)) {
                 const auto attrs { make_attrs(priority_) };
                 prolog(attrs);
                 static constexpr ostream& (*el)(ostream&) = &std::endl;
@@ -444,7 +1044,7 @@ public:
             return *this;
         }
         log& flush() {
-            if (priority_ <= category_type::level()) {
+            if (enabled(priority_)) {
                 flush(make_attrs(priority_));
             }
             return *this;
@@ -452,10 +1052,10 @@ public:
 #if defined(__cpp_lib_format)
         template<typename ... T>
         void format(std::basic_format_string<char_type, std::type_identity_t<T>...> fmt, T&&... args) {
-            if (priority_ <= category_type::level()) {
+            if (enabled(priority_)) {
+                const detail::sink_guard<category_type> guard { basic_emitter::pinned_ };
                 const auto attrs { make_attrs(priority_) };
-                prolog(attrs);
-                basic_emitter::format(fmt, std::forward<T>(args)...);
+                if (prolog(attrs)) basic_emitter::format(fmt, std::forward<T>(args)...);
                 flush(attrs);
             }
         }
@@ -464,6 +1064,7 @@ public:
         using basic_emitter::flush;
         using basic_emitter::prolog;
         using basic_emitter::make_attrs;
+        using basic_emitter::enabled;
         priority priority_;
     };
     // Representations changers
@@ -487,6 +1088,25 @@ public:
     static constexpr auto fix(T ... values) noexcept {
         return fixed<Width, Precision, T...> { values... };
     }
+    // Records the value into the histogram of the call site, requires <logovod/metric.h>.
+    // The name must outlive the program, e.g. a string literal
+    template<typename T>
+    static void metric(std::string_view name, T value, source_location sl = source_location::current()) {
+        detail::metrics<Category>::record(name, static_cast<std::int64_t>(value), sl);
+    }
+    // Adds delta to the counter of the call site, requires <logovod/metric.h>
+    static void count(std::string_view name, std::int64_t delta = 1, source_location sl = source_location::current()) {
+        detail::metrics<Category>::add(name, delta, sl);
+    }
+    // Upper bound of the payload length of a statement with arguments of the given types,
+    // detail::unbounded if not known at compile time
+    template<typename ... T>
+    static constexpr std::size_t max_size = printer::template max_size<std::remove_cv_t<std::remove_reference_t<T>>...>();
+    // Whether the payload of a statement may be truncated by the length limit, the prolog is not accounted, e.g.
+    // static_assert(!Log::may_truncate<int, decltype("ms")>);
+    template<typename ... T>
+    static constexpr bool may_truncate = !category_type::chunked
+        && max_size<T...> > std::max(category_type::length_limit, category_type::spill_limit);
 // Shortcodes
     using d = emitter<priority::debug>;
     using i = emitter<priority::informational>;
@@ -512,39 +1132,195 @@ public:
     using emergency     = emitter<priority::emergency>;
 };
 
+namespace detail {
+// Run-time configurable categories register on first use, making them available for configuring by tag
+struct category_entry {
+    std::string_view tag;
+    priority (*level)() noexcept;
+    // setters are nullptr if the category is not configurable in that aspect
+    void (*set_level)(priority) noexcept;
+    // resets the level to the base category level
+    void (*reset_level)() noexcept;
+    // sink getters and setters are provided for narrow char categories only.
+    sink::bundle::writer_type (*writer)() noexcept;
+    // members of the bundle that are nullptr are left unchanged
+    void (*set_sink)(sink::bundle) noexcept;
+    // resets the sink to the base category sink
+    void (*reset_sink)() noexcept;
+    const category_entry* next;
+    // settings applied by the configuration, maintained by the configuration
+    mutable unsigned configured;
+};
+
+class registry {
+public:
+    using hook_type = void(*)(const category_entry&) noexcept;
+    static const category_entry* head() noexcept { return head_.load(std::memory_order_acquire); }
+    static void add(category_entry& entry) noexcept {
+        entry.next = head_.load(std::memory_order_relaxed);
+        while (!head_.compare_exchange_weak(entry.next, &entry, std::memory_order_release, std::memory_order_relaxed));
+        if (const auto hook { hook_.load(std::memory_order_acquire) }) hook(entry);
+    }
+    // Hook is called for each category, registered after the hook is set
+    static void hook(hook_type value) noexcept { hook_.store(value, std::memory_order_release); }
+    template<typename Function>
+    static void for_each(Function&& function) {
+        for (auto entry { head() }; entry != nullptr; entry = entry->next) function(*entry);
+    }
+private:
+    static inline std::atomic<const category_entry*> head_ {};
+    static inline std::atomic<hook_type> hook_ {};
+};
+
+template<class Category, typename = void>
+inline constexpr bool has_level_setter_v = false;
+template<class Category>
+inline constexpr bool has_level_setter_v<Category, std::void_t<decltype(Category::level(priority{}))>> = true;
+
+template<class Category, typename = void>
+inline constexpr bool has_level_reset_v = false;
+template<class Category>
+inline constexpr bool has_level_reset_v<Category, std::void_t<decltype(Category::nolevel())>> = true;
+
+template<class Category>
+inline constexpr bool is_narrow_v = std::is_same_v<typename Category::char_type, char>;
+
+template<class Category, typename = void>
+inline constexpr bool has_sink_setter_v = false;
+template<class Category>
+inline constexpr bool has_sink_setter_v<Category, std::void_t<decltype(Category::sink(sink::bundle{}))>> = is_narrow_v<Category>;
+
+template<class Category, typename = void>
+inline constexpr bool has_sink_reset_v = false;
+template<class Category>
+inline constexpr bool has_sink_reset_v<Category, std::void_t<decltype(Category::nosink())>> = is_narrow_v<Category>;
+
+template<class Category>
+inline constexpr bool has_writer_v = is_narrow_v<Category>
+    && std::is_convertible_v<decltype(Category::writer()), sink::bundle::writer_type>;
+
+template<class Category>
+class registration {
+public:
+    // odr-uses the node, so that it is instantiated and registered on the program start
+    static void touch() noexcept { static_cast<void>(&node_); }
+private:
+    struct node : category_entry {
+        node() noexcept : category_entry { Category::tag, get_level, level_setter(), level_resetter(),
+            writer_getter(), sink_setter(), sink_resetter(), nullptr, 0 } {
+            registry::add(*this);
+        }
+    };
+    static priority get_level() noexcept { return Category::level(); }
+    static constexpr auto level_setter() noexcept {
+        void (*result)(priority) noexcept { nullptr };
+        if constexpr (has_level_setter_v<Category>) {
+            result = [](priority value) noexcept { Category::level(value); };
+        }
+        return result;
+    }
+    static constexpr auto level_resetter() noexcept {
+        void (*result)() noexcept { nullptr };
+        if constexpr (has_level_reset_v<Category>) {
+            result = []() noexcept { Category::nolevel(); };
+        }
+        return result;
+    }
+    static constexpr auto writer_getter() noexcept {
+        sink::bundle::writer_type (*result)() noexcept { nullptr };
+        if constexpr (has_writer_v<Category>) {
+            result = []() noexcept -> sink::bundle::writer_type { return Category::writer(); };
+        }
+        return result;
+    }
+    static constexpr auto sink_setter() noexcept {
+        void (*result)(sink::bundle) noexcept { nullptr };
+        if constexpr (has_sink_setter_v<Category>) {
+            result = [](sink::bundle bundle) noexcept {
+                if (bundle.prolog != nullptr) Category::prolog(bundle.prolog);
+                if (bundle.writer != nullptr) Category::writer(bundle.writer);
+                if (bundle.epliog != nullptr) Category::epilog(bundle.epliog);
+            };
+        }
+        return result;
+    }
+    static constexpr auto sink_resetter() noexcept {
+        void (*result)() noexcept { nullptr };
+        if constexpr (has_sink_reset_v<Category>) {
+            result = []() noexcept { Category::nosink(); };
+        }
+        return result;
+    }
+    static inline node node_ {};
+};
+} // namespace detail
+
+// Levels and sinks of the runtime categories may be changed while other threads are logging.
+// Levels are read with relaxed loads, so the check costs the same as a plain variable
 template<class Category, class Base>
 struct runtime_level : Base {
-  static priority level() noexcept { return level_; }
-  static void level(priority value) noexcept { level_ = value; }
+  static priority level() noexcept {
+      detail::registration<Category>::touch();
+      return level_.load(std::memory_order_relaxed);
+  }
+  static void level(priority value) noexcept {
+      detail::registration<Category>::touch();
+      level_.store(value, std::memory_order_relaxed);
+      detail::advance_generation();
+  }
+  // Restores the level of the base category
+  static void nolevel() noexcept { level(Base::level()); }
 private:  
-  static inline priority level_ { Base::level() };
+  static inline std::atomic<priority> level_ { Base::level() };
 };
 
+// Sink functions are pinned by emitters for the duration of a call.
+// A replaced sink may still be in use until synchronize() returns,
+// release resources of a replaced sink only after that.
 template<class Category, class Base>
 struct runtime_sink : Base {
   using writer_type = typename Base::sink_types::writer_type;
   using prologer = typename Base::sink_types::prologer;
   using epiloger = typename Base::sink_types::epiloger;
-  static auto writer() noexcept { return writer_; }
-  static void writer(writer_type value) noexcept { writer_ = value; }
-  static auto prolog() noexcept { return prolog_; }
-  static void prolog(prologer value) noexcept { prolog_ = value; }
-  static auto epilog() noexcept { return epilog_; }
-  static void epilog(epiloger value) noexcept { epilog_ = value; }
+  static auto writer() noexcept {
+      detail::registration<Category>::touch();
+      return writer_.load(std::memory_order_acquire);
+  }
+  static void writer(writer_type value) noexcept {
+      writer_.store(value, std::memory_order_release);
+      detail::advance_generation();
+  }
+  static auto prolog() noexcept { return prolog_.load(std::memory_order_acquire); }
+  static void prolog(prologer value) noexcept {
+      prolog_.store(value, std::memory_order_release);
+      detail::advance_generation();
+  }
+  static auto epilog() noexcept { return epilog_.load(std::memory_order_acquire); }
+  static void epilog(epiloger value) noexcept {
+      epilog_.store(value, std::memory_order_release);
+      detail::advance_generation();
+  }
   static void sink(sink::bundle bundle) noexcept {
-      prolog_ = bundle.prolog;
-      writer_ = bundle.writer;
-      epilog_ = bundle.epliog;
+      sink(bundle.prolog, bundle.writer, bundle.epliog);
   }
   static void sink(prologer p, writer_type w, epiloger e) noexcept {
-      prolog_ = p;
-      writer_ = w;
-      epilog_ = e;
+      prolog_.store(p, std::memory_order_release);
+      writer_.store(w, std::memory_order_release);
+      epilog_.store(e, std::memory_order_release);
+      detail::advance_generation();
+  }
+  // Restores the sink of the base category
+  static void nosink() noexcept {
+      sink(Base::prolog(), Base::writer(), Base::epilog());
   }
+  // Waits until emitters, that might have obtained a replaced sink, are done with it
+  static void synchronize() noexcept { epoch_.synchronize(); }
+  static detail::epoch& epoch() noexcept { return epoch_; }
 private:
-  static inline auto writer_ { Base::writer() };
-  static inline auto prolog_ { Base::prolog() };
-  static inline auto epilog_ { Base::epilog() };
+  static inline std::atomic<writer_type> writer_ { Base::writer() };
+  static inline std::atomic<prologer> prolog_ { Base::prolog() };
+  static inline std::atomic<epiloger> epilog_ { Base::epilog() };
+  static inline detail::epoch epoch_ { };
 };
 
 } // namespace logovod
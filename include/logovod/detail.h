@@ -8,11 +8,16 @@
  */
 
 #pragma once
+#include <algorithm>
+#include <charconv>
 #include <cstdint>
 #include <iterator>
 #include <iomanip>
+#include <limits>
+#include <locale>
 #include <tuple>
 #include <type_traits>
+#include <utility>
 #if (__cplusplus < 201703L)
 #error "At least C++17 is required"
 #endif
@@ -138,6 +143,12 @@ template<typename Stream, typename Type>
 inline constexpr bool use_default_lshift = have_lshift_operator_v<Stream, Type> && !(std::is_array_v<Type>
   && !std::is_same_v<std::remove_extent_t<Type>, char> && !std::is_same_v<std::remove_extent_t<Type>, wchar_t>);
 
+// Upper bound of the length of the text of a value, unbounded if not known at compile time
+inline constexpr std::size_t unbounded = std::numeric_limits<std::size_t>::max();
+
+template<typename Stream, typename T>
+constexpr std::size_t max_width() noexcept;
+
 template<typename CharT, class Traits = std::char_traits<CharT>>
 class basic_printer {
 public:
@@ -148,14 +159,26 @@ public:
   using delimiter_type = basic_delimiter<char_type>;
   using separators_type = basic_separators<char_type>;
 
-  basic_printer(std::size_t range_limit, string_view ellipsis, delimiter_type dlm, separators_type sep)
-    :  range_limit_{range_limit}, ellipsis_ {ellipsis}, sep_{sep}, dlm_{dlm} { }
+  basic_printer(std::size_t range_limit, string_view ellipsis, delimiter_type dlm, separators_type sep,
+                std::size_t element_limit = unbounded, std::size_t byte_limit = unbounded)
+    :  range_limit_{range_limit}, element_limit_{element_limit}, byte_limit_{byte_limit}, elements_{element_limit},
+       ellipsis_ {ellipsis}, sep_{sep}, dlm_{dlm} { }
   basic_printer(const basic_printer&) = default;
   basic_printer(basic_printer&&) = default;
   basic_printer& operator=(const basic_printer&) = default;
   basic_printer& operator=(basic_printer&&) = default;
   template<typename Type, typename ... List>
   void operator()(ostream& out, const Type& value, const List& ... values) {
+      // the rest of the statement is skipped, once nothing more can be written
+      if (exhausted(out)) return;
+      if constexpr(is_literal<Type>()) {
+          // runs of literals, with delimiters, are written at once
+          if (depth_ == 0 && out.width() == 0) {
+              literal_run<run_size<Type, List...>()> run;
+              coalesce(out, run, value, values...);
+              return;
+          }
+      }
       if constexpr(std::is_same_v<Type, delimiter_type> || std::is_same_v<Type, separators_type>) {
           operator()(value);
       } else {
@@ -170,11 +193,13 @@ public:
               start(out);
               auto limit { range_limit_ };
               for(const auto& i : value) {
+                  if (!out.good() || spent_) break;
                   if (dlm != '\0') out << dlm;
-                  if( limit-- == 0 ) {
+                  if( limit-- == 0 || elements_ == 0 ) {
                     out << ellipsis_;
                     break;
                   }
+                  --elements_;
                   operator()(out, i);
                   dlm = sep_.delim;
               }
@@ -183,17 +208,100 @@ public:
               formatter<Type>{}(*this, out, value);
           }
     }
+    if (spent_) return;
 
     if ((!no_dlm_after<Type>() || depth_ != 0) && !no_dlm_before<List...>()) {
+        if constexpr(sizeof...(List) != 0) {
+            // the delimiter joins the run of literals that follows
+            if constexpr(is_literal<std::tuple_element_t<0, std::tuple<List...>>>()) {
+                if (depth_ == 0 && out.width() == 0) {
+                    literal_run<1 + run_size<List...>()> run;
+                    if (dlm_.value != '\0') run.append(dlm_.value);
+                    coalesce(out, run, values...);
+                    return;
+                }
+            }
+        }
         delimiter(out);
     }
     if constexpr(sizeof...(List) != 0) {
         operator()(out, values...);
     }
   }
+  // Upper bound of the length of the text of the values with delimiters
+  template<typename ... List>
+  static constexpr std::size_t max_size() noexcept {
+      std::size_t result { sizeof...(List) };
+      for (auto width : { std::size_t {}, max_width<ostream, List>()... }) {
+          if (width == unbounded || result > unbounded - width) return unbounded;
+          result += width;
+      }
+      return result;
+  }
+  // Whether values of the types can be written directly to a buffer, bypassing the stream
+  template<typename ... List>
+  static constexpr bool direct() noexcept {
+      return std::is_same_v<char_type, char> && max_size<List...>() != unbounded && (is_direct<List>() && ...);
+  }
+  // Whether the stream is in the state, in which direct writes produce the same text
+  template<typename ... List>
+  static bool plain(const ostream& out) noexcept {
+      constexpr auto fields { std::ios_base::basefield | std::ios_base::showpos | std::ios_base::boolalpha };
+      if (!out.good() || out.width() != 0 || (out.flags() & fields) != std::ios_base::dec) return false;
+      if constexpr((is_number<List>() || ...)) {
+          // locales with digit grouping are handled by the stream
+          static const auto classic { &std::use_facet<std::numpunct<char_type>>(std::locale::classic()) };
+          return &std::use_facet<std::numpunct<char_type>>(out.getloc()) == classic;
+      } else {
+          return true;
+      }
+  }
+  // Writes values, as operator() does, to the buffer of max_size<Type, List...>() characters,
+  // returns the end of the written text
+  template<typename Type, typename ... List>
+  char_type* direct(char_type* pos, const Type& value, const List& ... values) noexcept {
+      if constexpr(std::is_same_v<Type, delimiter_type>) {
+          operator()(value);
+      } else if constexpr(std::is_same_v<Type, char_type>) {
+          *pos++ = value;
+      } else if constexpr(std::is_same_v<Type, bool>) {
+          *pos++ = value ? '1' : '0';
+      } else if constexpr(is_number<Type>()) {
+          pos = std::to_chars(pos, pos + max_width<ostream, Type>(), +value).ptr;
+      } else {
+          const auto terminated { char_traits::length(value) };
+          const auto length { terminated < std::extent_v<Type> ? terminated : std::extent_v<Type> };
+          pos = char_traits::copy(pos, value, length) + length;
+      }
+      if ((!no_dlm_after<Type>() || depth_ != 0) && !no_dlm_before<List...>() && dlm_.value != '\0') {
+          *pos++ = dlm_.value;
+      }
+      if constexpr(sizeof...(List) != 0) {
+          return direct(pos, values...);
+      } else {
+          return pos;
+      }
+  }
   void operator()(separators_type sep) noexcept { sep_ = sep; }
   void operator()(delimiter_type dlm) noexcept { dlm_ = dlm; }
-  void reset(delimiter_type dlm, separators_type sep) noexcept { dlm_ = dlm; sep_ = sep; }
+  void reset(delimiter_type dlm, separators_type sep) noexcept {
+      dlm_ = dlm;
+      sep_ = sep;
+      elements_ = element_limit_;
+      spent_ = false;
+  }
+  // Whether the formatting was stopped by the byte limit
+  bool spent() const noexcept { return spent_; }
+  // Whether the stream cannot take more, or the byte limit is reached, the latter is marked with the ellipsis
+  bool exhausted(ostream& out) {
+      if (!out.good() || spent_) return true;
+      if (byte_limit_ == unbounded) return false;
+      const auto pos { static_cast<std::streamoff>(out.tellp()) };
+      if (pos < 0 || static_cast<std::size_t>(pos) < byte_limit_) return false;
+      out << ellipsis_;
+      spent_ = true;
+      return true;
+  }
   void start(ostream& out) { if (sep_.start != '\0') out << sep_.start; depth_++; }
   void finish(ostream& out) { if (sep_.finish != '\0') out << sep_.finish; depth_--; }
   void delimiter(ostream& out) { if (dlm_.value != '\0') out << dlm_.value; }
@@ -205,6 +313,66 @@ private:
   template<typename>
   friend class formatter;
 
+  // Integers and scoped enumerations, printed as their values
+  template<typename T>
+  static constexpr bool is_number() noexcept {
+      if constexpr(std::is_enum_v<T>) {
+          return !have_lshift_operator_v<ostream, T>;
+      } else {
+          return std::is_integral_v<T> && !std::is_same_v<T, bool> && !std::is_same_v<T, char_type>;
+      }
+  }
+  template<typename T>
+  static constexpr bool is_direct() noexcept {
+      return std::is_same_v<T, delimiter_type> || std::is_same_v<T, char_type> || std::is_same_v<T, bool>
+          || is_number<T>() || is_literal<T>();
+  }
+  // Character arrays, string literals in the first place, short enough to be copied to the stack
+  template<typename T>
+  static constexpr bool is_literal() noexcept {
+      return std::is_array_v<T> && std::is_same_v<std::remove_cv_t<std::remove_extent_t<T>>, char_type>
+          && std::extent_v<T> <= 256;
+  }
+  // Space for the leading run of literals and their delimiters
+  template<typename T, typename ... List>
+  static constexpr std::size_t run_size() noexcept {
+      if constexpr(!is_literal<T>()) {
+          return 0;
+      } else if constexpr(sizeof...(List) == 0) {
+          return std::extent_v<T>;
+      } else {
+          return std::extent_v<T> + run_size<List...>();
+      }
+  }
+  template<std::size_t Size>
+  struct literal_run {
+      char_type text[Size];
+      std::size_t size {};
+      void append(char_type c) noexcept { text[size++] = c; }
+      template<std::size_t N>
+      void append(const char_type (&value)[N]) noexcept {
+          // as with operator<<, literals end at the first null character, the copy is bounded by the array size
+          const auto terminated { char_traits::length(value) };
+          const auto length { terminated < N ? terminated : N };
+          char_traits::copy(text + size, value, length);
+          size += length;
+      }
+  };
+  template<std::size_t Size, typename Type, typename ... List>
+  void coalesce(ostream& out, literal_run<Size>& run, const Type& value, const List& ... values) {
+      run.append(value);
+      if (!no_dlm_before<List...>() && dlm_.value != '\0') run.append(dlm_.value);
+      if constexpr(sizeof...(List) != 0) {
+          if constexpr(is_literal<std::tuple_element_t<0, std::tuple<List...>>>()) {
+              coalesce(out, run, values...);
+          } else {
+              out.write(run.text, static_cast<std::streamsize>(run.size));
+              operator()(out, values...);
+          }
+      } else {
+          out.write(run.text, static_cast<std::streamsize>(run.size));
+      }
+  }
   template<typename T>
   static constexpr bool is_manip() noexcept {
       using namespace std;
@@ -232,10 +400,14 @@ private:
       }
   }
   std::size_t range_limit_;
+  std::size_t element_limit_;
+  std::size_t byte_limit_;
+  std::size_t elements_;
   string_view ellipsis_;
   separators_type sep_;
   delimiter_type dlm_;
   uint8_t depth_ {};
+  bool spent_ {};
 };
 } // namespace detail
 
@@ -259,6 +431,46 @@ struct fixed {
     std::tuple<T ...> values;
 };
 
+namespace detail {
+template<typename T>
+inline constexpr bool is_fixed_v = false;
+
+template<unsigned Width, unsigned Precision, typename ... T>
+inline constexpr bool is_fixed_v<fixed<Width, Precision, T...>> = true;
+
+// Fixed notation is limited by the width only from below, the bound is of the largest value
+template<typename T, std::size_t ... I>
+constexpr std::size_t fixed_width(std::index_sequence<I...>) noexcept {
+    return ((std::max<std::size_t>(T::width, static_cast<std::size_t>(std::numeric_limits<std::tuple_element_t<I,
+            decltype(T::values)>>::max_exponent10) + T::precision + 3) + 1) + ... + 0);
+}
+
+template<typename Stream, typename T>
+constexpr std::size_t max_width() noexcept {
+    using char_type = typename Stream::char_type;
+    using printer = basic_printer<char_type, typename Stream::traits_type>;
+    if constexpr(std::is_same_v<T, typename printer::delimiter_type> || std::is_same_v<T, typename printer::separators_type>) {
+        return 0;
+    } else if constexpr(std::is_same_v<T, char_type>) {
+        return 1;
+    } else if constexpr(std::is_same_v<T, bool>) {
+        return 5; // "false" with std::boolalpha
+    } else if constexpr(std::is_enum_v<T>) {
+        return have_lshift_operator_v<Stream, T> ? unbounded : max_width<Stream, std::underlying_type_t<T>>();
+    } else if constexpr(std::is_integral_v<T>) {
+        // octal representation is the longest, with sign or base prefix
+        return (static_cast<std::size_t>(std::numeric_limits<T>::digits) + 2) / 3 + 2;
+    } else if constexpr(std::is_array_v<T> && std::is_same_v<std::remove_cv_t<std::remove_extent_t<T>>, char_type>) {
+        return std::extent_v<T>;
+    } else if constexpr(is_fixed_v<T>) {
+        return fixed_width<T>(std::make_index_sequence<std::tuple_size_v<decltype(T::values)>>{});
+    } else {
+        return unbounded;
+    }
+}
+
+} // namespace detail
+
 template<radix Radix, typename ... T>
 struct formatter<representation<Radix, T...>> {
     template<typename Printer, typename Stream>
@@ -36,6 +36,14 @@ public:
   std::basic_string_view<char_type, traits_type> view() const noexcept {
     return { base::pbase(), static_cast<std::size_t>(ppos()) };
   }
+  // Space for writing up to size characters directly, nullptr if the space is not available
+  char_type* reserve(std::size_t size) noexcept {
+    return static_cast<std::size_t>(base::epptr() - base::pptr()) >= size ? base::pptr() : nullptr;
+  }
+  // Accounts characters written directly to the reserved space
+  void commit(char_type* end) noexcept {
+    base::pbump(static_cast<int>(end - base::pptr()));
+  }
   inline static const pos_type npos = -1;
   streamsize available() const noexcept {
       return static_cast<streamsize>(Size) - ppos();
@@ -77,5 +85,54 @@ private:
 template<std::size_t Size>
 using fixedbuf = basic_fixedbuf<Size, char>;
 
+// Fixed buffer, which hands the message over to its owner in chunks, when it is full, instead of truncating it.
+// The last Reserve characters are kept for the epilog, written after the owner calls extend()
+template<std::size_t Size, class CharT, class Traits = std::char_traits<CharT>>
+class basic_chunkbuf : public basic_fixedbuf<Size, CharT, Traits> {
+public:
+  static constexpr std::size_t reserved = 16;
+  static_assert(Size > 2 * reserved, "Size is too small for chunks");
+  using base = basic_fixedbuf<Size, CharT, Traits>;
+  using char_type = typename base::char_type;
+  using traits_type = typename base::traits_type;
+  using pos_type = typename base::pos_type;
+  using off_type = typename base::off_type;
+  using int_type = typename base::int_type;
+  // Writes the chunk out and rewinds the buffer, returns false if the message is to be truncated instead
+  using handler_type = bool (*)(void* owner);
+  basic_chunkbuf() : base{} { limit(); }
+  void handler(handler_type function, void* owner) noexcept {
+    handler_ = function;
+    owner_ = owner;
+  }
+  // Makes the reserved space available, until the buffer is rewound
+  void extend() noexcept {
+    const auto pos { base::pptr() - base::pbase() };
+    base::setp(base::pbase(), base::pbase() + Size);
+    base::pbump(static_cast<int>(pos));
+  }
+protected:
+  int_type overflow(int_type c) override {
+    if (traits_type::eq_int_type(c, traits_type::eof())) return traits_type::not_eof(c);
+    if (!extended() && handler_ != nullptr) {
+      if (!handler_(owner_)) return traits_type::eof();
+    }
+    if (base::pptr() == base::epptr()) return traits_type::eof();
+    *base::pptr() = traits_type::to_char_type(c);
+    base::pbump(1);
+    return c;
+  }
+  pos_type seekpos(pos_type pos, std::ios_base::openmode mode) override {
+    const auto result { base::seekpos(pos, mode) };
+    if (result == pos_type(0)) limit();
+    return result;
+  }
+private:
+  bool extended() const noexcept { return base::epptr() == base::pbase() + Size; }
+  void limit() noexcept { base::setp(base::pbase(), base::pbase() + (Size - reserved)); }
+  handler_type handler_ {};
+  void* owner_ {};
+};
+
 } // logovod::detail
 
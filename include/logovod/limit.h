@@ -0,0 +1,163 @@
+/*
+ * Copyright (C) 2024 Eugene Hutorny <eugene@hutorny.in.ua>
+ *
+ * This file is a part of logovod library
+ *
+ * Licensed under MIT License, see full text in LICENSE
+ * or visit page https://opensource.org/license/mit/
+ */
+
+#pragma once
+#include <logovod/core.h>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+
+// Per call site limiters. A category enables a limiter by providing it with a static member function, e.g.
+// static constexpr auto limiter() noexcept { return limit::token_bucket { 10, std::chrono::seconds { 1 } }; }
+// Limiters are checked before the prolog, suppressed messages are not formatted.
+// The first admitted message after suppression is annotated with the number of suppressed messages.
+// Call sites are identified by source location, statements without location share one state per category
+namespace logovod::limit {
+
+struct decision {
+    bool admitted;
+    // messages suppressed since the previous admitted one
+    std::uint64_t suppressed;
+};
+
+namespace detail {
+constexpr std::uint64_t mix(std::uint64_t x) noexcept {
+    x += 0x9E3779B97F4A7C15ull;
+    x = (x ^ (x >> 30)) * 0xBF58476D1CE4E5B9ull;
+    x = (x ^ (x >> 27)) * 0x94D049BB133111EBull;
+    return x ^ (x >> 31);
+}
+
+// Hash of the call site, independent of addresses
+inline std::uint64_t seed(const char* file, std::uint_least32_t line) noexcept {
+    std::uint64_t hash { 0xCBF29CE484222325ull };
+    for (auto name { file }; name != nullptr && *name != '\0'; ++name) {
+        hash = (hash ^ static_cast<unsigned char>(*name)) * 0x100000001B3ull;
+    }
+    return mix(hash ^ line);
+}
+
+struct state {
+    std::atomic<std::uint64_t> key;
+    std::atomic<std::uint64_t> seed;
+    std::atomic<std::int64_t> value;
+    std::atomic<std::uint64_t> suppressed;
+    // called once, by the thread that claimed the slot
+    void claim(const char* file, std::uint_least32_t line) noexcept {
+        seed.store(detail::seed(file, line), std::memory_order_release);
+    }
+};
+
+// Lock-free open addressing table of call site states, one per category and limiter.
+// Slots are never released, call sites that do not fit in are not limited
+template<class Category, class Limiter, class State = state>
+class sites {
+public:
+    static constexpr std::size_t capacity = 256;
+    static State* find(const char* file, std::uint_least32_t line) noexcept {
+        const auto key { mix(reinterpret_cast<std::uintptr_t>(file) ^ (std::uint64_t { line } << 48)) | 1u };
+        for (std::size_t i = 0; i < capacity; ++i) {
+            auto& slot { slots_[(key + i) % capacity] };
+            auto current { slot.key.load(std::memory_order_acquire) };
+            if (current == 0 && slot.key.compare_exchange_strong(current, key, std::memory_order_acq_rel)) {
+                slot.claim(file, line);
+                return &slot;
+            }
+            if (current == key) return &slot;
+        }
+        return nullptr;
+    }
+    static State* find(const source_location& sl) noexcept {
+        return find(sl.file_name(), sl.line());
+    }
+    // Calls function for each claimed slot
+    template<typename Function>
+    static void for_each(Function&& function) {
+        for (auto& slot : slots_) {
+            if (slot.key.load(std::memory_order_acquire) != 0) function(slot);
+        }
+    }
+private:
+    static inline State slots_[capacity] {};
+};
+
+template<class Limiter>
+struct basic {
+    template<class Category>
+    decision admit(const source_location& sl) const noexcept {
+        const auto state { sites<Category, Limiter>::find(sl) };
+        if (state == nullptr) return { true, 0 };
+        if (!static_cast<const Limiter&>(*this).pass(*state)) {
+            state->suppressed.fetch_add(1, std::memory_order_relaxed);
+            return { false, 0 };
+        }
+        const auto suppressed { state->suppressed.load(std::memory_order_relaxed) };
+        return { true, suppressed == 0 ? 0 : state->suppressed.exchange(0, std::memory_order_relaxed) };
+    }
+};
+} // namespace detail
+
+// Admits up to count messages per period, refilled continuously (token bucket as a generic cell rate algorithm)
+class token_bucket : public detail::basic<token_bucket> {
+public:
+    using clock = std::chrono::steady_clock;
+    constexpr token_bucket(std::uint32_t count, clock::duration period) noexcept
+      : interval_ { period.count() / (count == 0 ? 1 : count) }, tolerance_ { period.count() - interval_ } {}
+    bool pass(detail::state& state) const noexcept {
+        const auto now { clock::now().time_since_epoch().count() };
+        // value is the theoretical arrival time of the next message
+        auto tat { state.value.load(std::memory_order_relaxed) };
+        for (;;) {
+            const auto base { tat < now ? now : tat };
+            if (base - now > tolerance_) return false;
+            if (state.value.compare_exchange_weak(tat, base + interval_, std::memory_order_relaxed)) return true;
+        }
+    }
+private:
+    clock::rep interval_;
+    clock::rep tolerance_;
+};
+
+// Admits the first count messages
+class first : public detail::basic<first> {
+public:
+    constexpr explicit first(std::int64_t count) noexcept : count_ { count } {}
+    bool pass(detail::state& state) const noexcept {
+        if (state.value.load(std::memory_order_relaxed) >= count_) return false;
+        return state.value.fetch_add(1, std::memory_order_relaxed) < count_;
+    }
+private:
+    std::int64_t count_;
+};
+
+// Admits every n-th message, starting from the first one
+class every : public detail::basic<every> {
+public:
+    constexpr explicit every(std::int64_t n) noexcept : n_ { n < 1 ? 1 : n } {}
+    bool pass(detail::state& state) const noexcept {
+        return state.value.fetch_add(1, std::memory_order_relaxed) % n_ == 0;
+    }
+private:
+    std::int64_t n_;
+};
+
+// Admits one message in n on average, chosen by a hash of the call site file name, line and the message
+// sequence number, so that the same messages are sampled across runs
+class sample : public detail::basic<sample> {
+public:
+    constexpr explicit sample(std::uint64_t n) noexcept : n_ { n < 1 ? 1 : n } {}
+    bool pass(detail::state& state) const noexcept {
+        const auto sequence { static_cast<std::uint64_t>(state.value.fetch_add(1, std::memory_order_relaxed)) };
+        return detail::mix(state.seed.load(std::memory_order_acquire) ^ sequence) % n_ == 0;
+    }
+private:
+    std::uint64_t n_;
+};
+
+} // namespace logovod::limit
@@ -0,0 +1,224 @@
+/*
+ * Copyright (C) 2024 Eugene Hutorny <eugene@hutorny.in.ua>
+ *
+ * This file is a part of logovod library
+ *
+ * Licensed under MIT License, see full text in LICENSE
+ * or visit page https://opensource.org/license/mit/
+ */
+
+#pragma once
+#include <logovod/aggregate.h>
+#include <memory>
+#include <string>
+#include <vector>
+
+// Metrics, recorded with Log::metric(name, value) into per thread histograms, and with Log::count(name, delta)
+// into per thread counters, both keyed by call site. aggregate::report() merges them and writes one record per site
+// with the category's logger at the informational level:
+// metric latency_us at server.cxx:120 count 1000 min 12 max 950 p50 40 p99 700 p999 930
+// counter retries at server.cxx:130 42
+// Metrics are recorded only when the informational level is enabled for the category
+namespace logovod::metrics {
+
+// Log-linear histogram of non-negative values with relative error below 1/32, negative values are counted as 0.
+// Counts are updated with uncontended atomic operations by the owning thread and taken by the reporter
+class histogram {
+public:
+    static constexpr unsigned sub_bits = 5;
+    static constexpr std::uint64_t sub_count = std::uint64_t { 1 } << sub_bits;
+    static constexpr std::size_t size = sub_count * (65 - sub_bits);
+
+    static constexpr unsigned msb(std::uint64_t value) noexcept {
+        unsigned result {};
+        for (unsigned shift = 32; shift != 0; shift /= 2) {
+            if ((value >> shift) != 0) {
+                value >>= shift;
+                result += shift;
+            }
+        }
+        return result;
+    }
+    static constexpr std::size_t bucket(std::uint64_t value) noexcept {
+        if (value < sub_count) return static_cast<std::size_t>(value);
+        const auto exponent { msb(value) - sub_bits };
+        return static_cast<std::size_t>(sub_count * exponent + (value >> exponent));
+    }
+    // Middle of the bucket's range
+    static constexpr std::uint64_t value(std::size_t bucket) noexcept {
+        if (bucket < 2 * sub_count) return bucket;
+        const auto exponent { bucket / sub_count - 1 };
+        const auto mantissa { bucket - sub_count * exponent };
+        return (std::uint64_t { mantissa } << exponent) + ((std::uint64_t { 1 } << exponent) >> 1);
+    }
+
+    void record(std::int64_t value) noexcept {
+        counts_[bucket(value < 0 ? 0 : static_cast<std::uint64_t>(value))].fetch_add(1, std::memory_order_relaxed);
+        count_.fetch_add(1, std::memory_order_relaxed);
+        sum_.fetch_add(value, std::memory_order_relaxed);
+        auto min { min_.load(std::memory_order_relaxed) };
+        while (value < min && !min_.compare_exchange_weak(min, value, std::memory_order_relaxed)) {}
+        auto max { max_.load(std::memory_order_relaxed) };
+        while (value > max && !max_.compare_exchange_weak(max, value, std::memory_order_relaxed)) {}
+    }
+
+    // Merged content of histograms, taken by the reporter
+    struct summary {
+        std::vector<std::uint64_t> counts = std::vector<std::uint64_t>(size);
+        std::uint64_t count {};
+        std::int64_t sum {};
+        std::int64_t min { std::numeric_limits<std::int64_t>::max() };
+        std::int64_t max { std::numeric_limits<std::int64_t>::min() };
+        // Value at the given quantile, clamped to the observed range
+        std::int64_t quantile(double q) const noexcept {
+            const auto rank { static_cast<std::uint64_t>(q * static_cast<double>(count) + 0.5) };
+            std::uint64_t seen {};
+            for (std::size_t i = 0; i < size; ++i) {
+                seen += counts[i];
+                if (seen != 0 && seen >= rank) {
+                    const auto v { static_cast<std::int64_t>(value(i)) };
+                    return v < min ? min : v > max ? max : v;
+                }
+            }
+            return max;
+        }
+    };
+    // Moves the content into the summary, resetting the histogram
+    void take(summary& s) noexcept {
+        const auto count { count_.exchange(0, std::memory_order_relaxed) };
+        if (count == 0) return;
+        for (std::size_t i = 0; i < size; ++i) s.counts[i] += counts_[i].exchange(0, std::memory_order_relaxed);
+        s.count += count;
+        s.sum += sum_.exchange(0, std::memory_order_relaxed);
+        const auto min { min_.exchange(std::numeric_limits<std::int64_t>::max(), std::memory_order_relaxed) };
+        const auto max { max_.exchange(std::numeric_limits<std::int64_t>::min(), std::memory_order_relaxed) };
+        if (min < s.min) s.min = min;
+        if (max > s.max) s.max = max;
+    }
+private:
+    std::atomic<std::uint32_t> counts_[size] {};
+    std::atomic<std::uint64_t> count_ {};
+    std::atomic<std::int64_t> sum_ {};
+    std::atomic<std::int64_t> min_ { std::numeric_limits<std::int64_t>::max() };
+    std::atomic<std::int64_t> max_ { std::numeric_limits<std::int64_t>::min() };
+};
+
+} // namespace logovod::metrics
+
+namespace logovod::detail {
+
+template<class Category>
+class metrics {
+public:
+    static constexpr std::size_t capacity = 32;
+    static void record(std::string_view name, std::int64_t value, const source_location& sl) {
+        if (priority::informational > Category::level()) return;
+        const auto s { local().find(name, sl, false) };
+        if (s != nullptr) s->histogram->record(value);
+    }
+    static void add(std::string_view name, std::int64_t delta, const source_location& sl) {
+        if (priority::informational > Category::level()) return;
+        const auto s { local().find(name, sl, true) };
+        if (s != nullptr) s->total.fetch_add(delta, std::memory_order_relaxed);
+    }
+    static void report() {
+        struct merged {
+            const char* file;
+            std::uint_least32_t line;
+            std::string_view name;
+            bool counter;
+            std::int64_t total;
+            logovod::metrics::histogram::summary summary;
+        };
+        std::vector<merged> sites;
+        {
+            std::lock_guard<std::mutex> lock { mutex() };
+            for (auto p { &head() }; *p != nullptr; ) {
+                auto& shard { **p };
+                const auto size { shard.size.load(std::memory_order_acquire) };
+                for (std::size_t i = 0; i < size; ++i) {
+                    auto& s { shard.sites[i] };
+                    auto m { std::find_if(sites.begin(), sites.end(), [&s](const merged& site) {
+                        return site.file == s.file && site.line == s.line && site.name == s.name && site.counter == s.counter;
+                    }) };
+                    if (m == sites.end()) m = sites.insert(sites.end(), { s.file, s.line, s.name, s.counter, 0, {} });
+                    if (s.counter) m->total += s.total.exchange(0, std::memory_order_relaxed);
+                    else s.histogram->take(m->summary);
+                }
+                if (shard.orphan.load(std::memory_order_acquire)) {
+                    *p = shard.next;
+                    delete &shard;
+                } else {
+                    p = &shard.next;
+                }
+            }
+        }
+        for (const auto& m : sites) {
+            const std::string location { std::string { m.file != nullptr ? m.file : "" } + ':' + std::to_string(m.line) };
+            if (m.counter) {
+                if (m.total != 0) typename logger<Category>::i("counter", m.name, "at", location, m.total);
+            } else if (m.summary.count != 0) {
+                const auto& s { m.summary };
+                typename logger<Category>::i("metric", m.name, "at", location, "count", s.count, "min", s.min, "max", s.max,
+                    "p50", s.quantile(0.5), "p99", s.quantile(0.99), "p999", s.quantile(0.999));
+            }
+        }
+    }
+private:
+    struct site {
+        const char* file;
+        std::uint_least32_t line;
+        std::string_view name;
+        bool counter;
+        std::atomic<std::int64_t> total;
+        std::unique_ptr<logovod::metrics::histogram> histogram;
+    };
+    // Sites of a thread, released by the reporter after the thread exits
+    struct shard {
+        site sites[capacity] {};
+        std::atomic<std::size_t> size {};
+        std::atomic<bool> orphan {};
+        shard* next {};
+        // Called by the owning thread only
+        site* find(std::string_view name, const source_location& sl, bool counter) {
+            const auto count { size.load(std::memory_order_relaxed) };
+            for (std::size_t i = 0; i < count; ++i) {
+                auto& s { sites[i] };
+                if (s.line == sl.line() && s.file == sl.file_name() && s.name.data() == name.data() && s.counter == counter) return &s;
+            }
+            if (count == capacity) return nullptr;
+            auto& s { sites[count] };
+            s.file = sl.file_name();
+            s.line = sl.line();
+            s.name = name;
+            s.counter = counter;
+            if (!counter) s.histogram = std::make_unique<logovod::metrics::histogram>();
+            size.store(count + 1, std::memory_order_release);
+            return &s;
+        }
+    };
+    struct holder {
+        holder() : instance { new shard {} } {
+            static const bool registered { (aggregate::detail::registry::add(node_), true) };
+            static_cast<void>(registered);
+            std::lock_guard<std::mutex> lock { mutex() };
+            instance->next = head();
+            head() = instance;
+        }
+        holder(const holder&) = delete;
+        holder(holder&&) = delete;
+        holder& operator=(const holder&) = delete;
+        holder& operator=(holder&&) = delete;
+        ~holder() { instance->orphan.store(true, std::memory_order_release); }
+        shard* instance;
+    };
+    static shard& local() {
+        static thread_local holder instance {};
+        return *instance.instance;
+    }
+    static std::mutex& mutex() noexcept { static std::mutex instance {}; return instance; }
+    static shard*& head() noexcept { static shard* instance {}; return instance; }
+    static inline aggregate::detail::registry::node node_ { report, nullptr };
+};
+
+} // namespace logovod::detail
@@ -9,6 +9,8 @@
 
 #pragma once
 #include <logovod/core.h>
+#include <atomic>
+#include <cstdint>
 #include <optional>
 
 namespace logovod {
@@ -24,13 +26,41 @@ struct formatter<std::optional<T>> {
     }
 };
 
+// Optional settings fall back to the base category when not set.
+// Each thread keeps settings resolved through the hierarchy and re-resolves them only when
+// the configuration generation changes, so the cost of a lookup does not depend on the hierarchy depth
 template<class Category, class Base>
 struct optional_level : Base {
-  static priority level() noexcept { return level_.has_value() ? level_.value() : Base::level(); }
-  static void level(priority value) noexcept { level_ = value; }
-  static void nolevel() noexcept { level_.reset(); }
+  static priority level() noexcept {
+      detail::registration<Category>::touch();
+      const auto generation { detail::generation() };
+      if (cache_.generation != generation) {
+          std::atomic_thread_fence(std::memory_order_acquire);
+          cache_ = { generation, resolve() };
+      }
+      return cache_.level;
+  }
+  static void level(priority value) noexcept {
+      detail::registration<Category>::touch();
+      level_.store(value, std::memory_order_relaxed);
+      detail::advance_generation();
+  }
+  static void nolevel() noexcept {
+      level_.store(none, std::memory_order_relaxed);
+      detail::advance_generation();
+  }
 private:
-  static inline std::optional<priority> level_ {};
+  static constexpr auto none = static_cast<priority>(-1);
+  static priority resolve() noexcept {
+      const auto value { level_.load(std::memory_order_relaxed) };
+      return value != none ? value : Base::level();
+  }
+  struct resolved {
+      std::uint64_t generation;
+      priority level;
+  };
+  static inline std::atomic<priority> level_ { none };
+  static inline thread_local resolved cache_ {};
 };
 
 template<class Category, class Base>
@@ -38,34 +68,73 @@ struct optional_sink : Base {
   using writer_type = typename Base::sink_types::writer_type;
   using prologer = typename Base::sink_types::prologer;
   using epiloger = typename Base::sink_types::epiloger;
-  static writer_type writer() noexcept { return writer_.has_value() ? writer_.value() : Base::writer(); }
-  static void writer(writer_type value) noexcept { writer_ = value; }
-  static void nowriter() noexcept { writer_.reset(); }
-  static prologer prolog() noexcept { return prolog_.has_value() ? prolog_.value() : Base::prolog(); }
-  static void prolog(prologer value) noexcept { prolog_ = value; }
-  static void noprolog() noexcept { prolog_.reset(); }
-  static epiloger epilog() noexcept { return epilog_.has_value() ? epilog_.value() : Base::epilog(); }
-  static void epilog(epiloger value) noexcept { epilog_ = value; }
-  static void noepilog() noexcept { epilog_.reset(); }
+  static writer_type writer() noexcept {
+      detail::registration<Category>::touch();
+      return resolved().writer;
+  }
+  static void writer(writer_type value) noexcept { store(writer_, value); }
+  static void nowriter() noexcept { store(writer_, nullptr); }
+  static prologer prolog() noexcept { return resolved().prolog; }
+  static void prolog(prologer value) noexcept { store(prolog_, value); }
+  static void noprolog() noexcept { store(prolog_, nullptr); }
+  static epiloger epilog() noexcept { return resolved().epilog; }
+  static void epilog(epiloger value) noexcept { store(epilog_, value); }
+  static void noepilog() noexcept { store(epilog_, nullptr); }
   static void sink(sink::bundle bundle) noexcept {
-      prolog_ = bundle.prolog;
-      writer_ = bundle.writer;
-      epilog_ = bundle.epliog;
+      sink(bundle.prolog, bundle.writer, bundle.epliog);
   }
   static void sink(prologer p, writer_type w, epiloger e) noexcept {
-      prolog_ = p;
-      writer_ = w;
-      epilog_ = e;
+      prolog_.store(p, std::memory_order_release);
+      writer_.store(w, std::memory_order_release);
+      epilog_.store(e, std::memory_order_release);
+      detail::advance_generation();
   }
   static void nosink() noexcept {
-      noprolog();
-      nowriter();
-      noepilog();
+      sink(nullptr, nullptr, nullptr);
+  }
+  // Waits until emitters, that might have obtained a replaced sink, are done with it
+  static void synchronize() noexcept { epoch().synchronize(); }
+  // Categories of one hierarchy share the epoch of the top-most run-time category
+  static detail::epoch& epoch() noexcept {
+      if constexpr (detail::has_epoch_v<Base>) {
+          return Base::epoch();
+      } else {
+          return epoch_;
+      }
   }
 private:
-  static inline std::optional<writer_type> writer_ {};
-  static inline std::optional<prologer> prolog_ {};
-  static inline std::optional<epiloger> epilog_ {};
+  struct settings {
+      std::uint64_t generation;
+      writer_type writer;
+      prologer prolog;
+      epiloger epilog;
+  };
+  static const settings& resolved() noexcept {
+      const auto generation { detail::generation() };
+      if (cache_.generation != generation) {
+          std::atomic_thread_fence(std::memory_order_acquire);
+          cache_ = { generation,
+              resolve(writer_, []() noexcept { return Base::writer(); }),
+              resolve(prolog_, []() noexcept { return Base::prolog(); }),
+              resolve(epilog_, []() noexcept { return Base::epilog(); }) };
+      }
+      return cache_;
+  }
+  template<typename T, typename Fallback>
+  static T resolve(const std::atomic<T>& value, Fallback fallback) noexcept {
+      const auto result { value.load(std::memory_order_acquire) };
+      return result != nullptr ? result : static_cast<T>(fallback());
+  }
+  template<typename T, typename V>
+  static void store(std::atomic<T>& dest, V value) noexcept {
+      dest.store(value, std::memory_order_release);
+      detail::advance_generation();
+  }
+  static inline std::atomic<writer_type> writer_ {};
+  static inline std::atomic<prologer> prolog_ {};
+  static inline std::atomic<epiloger> epilog_ {};
+  static inline detail::epoch epoch_ { };
+  static inline thread_local settings cache_ {};
 };
 
 template<class Category, class Base>
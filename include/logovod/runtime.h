@@ -0,0 +1,230 @@
+/*
+ * Copyright (C) 2024 Eugene Hutorny <eugene@hutorny.in.ua>
+ *
+ * This file is a part of logovod library
+ *
+ * Licensed under MIT License, see full text in LICENSE
+ * or visit page https://opensource.org/license/mit/
+ */
+
+#pragma once
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+#include <string_view>
+#include <thread>
+#include <type_traits>
+
+namespace logovod::detail {
+
+// Small sequential number of the calling thread, assigned on first use
+inline std::uint32_t thread_number() noexcept {
+    static std::atomic<std::uint32_t> next { 1 };
+    static thread_local const std::uint32_t number { next.fetch_add(1, std::memory_order_relaxed) };
+    return number;
+}
+
+// Two-phase epoch for deferred release of replaced sinks.
+// Emitters pin the current phase for the duration of a sink call,
+// synchronize() flips the phase and waits until readers of the previous phase are done.
+// Readers are counted in stripes, selected by the thread number, so threads do not contend on one cache line
+class epoch {
+public:
+    class guard {
+    public:
+        explicit guard(epoch& e) noexcept : epoch_ { e }, ticket_ { e.enter() } {}
+        guard(const guard&) = delete;
+        guard(guard&&) = delete;
+        guard& operator=(const guard&) = delete;
+        guard& operator=(guard&&) = delete;
+        ~guard() { epoch_.leave(ticket_); }
+    private:
+        epoch& epoch_;
+        unsigned ticket_;
+    };
+    static constexpr unsigned stripes = 16;
+    constexpr epoch() noexcept = default;
+    epoch(const epoch&) = delete;
+    epoch(epoch&&) = delete;
+    epoch& operator=(const epoch&) = delete;
+    epoch& operator=(epoch&&) = delete;
+
+    // Returns the ticket to be passed to leave
+    unsigned enter() noexcept {
+        auto& slot { stripes_[thread_number() % stripes] };
+        for(;;) {
+            const auto phase { phase_.load(std::memory_order_acquire) & 1u };
+            slot.readers[phase].fetch_add(1, std::memory_order_seq_cst);
+            // phase flipped in between - the reader may be unnoticed by synchronize, retry
+            if ((phase_.load(std::memory_order_seq_cst) & 1u) == phase) {
+                return static_cast<unsigned>(&slot - stripes_) * 2 + phase;
+            }
+            slot.readers[phase].fetch_sub(1, std::memory_order_release);
+        }
+    }
+    void leave(unsigned ticket) noexcept {
+        stripes_[ticket / 2].readers[ticket % 2].fetch_sub(1, std::memory_order_release);
+    }
+    // Must not be called from within a sink function of the same category
+    void synchronize() noexcept {
+        std::lock_guard<std::mutex> lock { mutex_ };
+        const auto phase { phase_.fetch_add(1, std::memory_order_seq_cst) & 1u };
+        for (auto& slot : stripes_) {
+            while (slot.readers[phase].load(std::memory_order_acquire) != 0) std::this_thread::yield();
+        }
+    }
+private:
+    struct alignas(64) stripe {
+        std::atomic<std::size_t> readers[2] {};
+    };
+    std::atomic<unsigned> phase_ {};
+    stripe stripes_[stripes] {};
+    std::mutex mutex_ {};
+};
+
+template<class Category, typename = void>
+inline constexpr bool has_epoch_v = false;
+
+template<class Category>
+inline constexpr bool has_epoch_v<Category, std::void_t<decltype(Category::epoch())>> = true;
+
+template<class Category, typename = void>
+inline constexpr bool has_limiter_v = false;
+
+template<class Category>
+inline constexpr bool has_limiter_v<Category, std::void_t<decltype(Category::limiter())>> = true;
+
+template<class Category, typename = void>
+inline constexpr bool has_backlog_v = false;
+
+template<class Category>
+inline constexpr bool has_backlog_v<Category, std::void_t<decltype(Category::backlog())>> = true;
+
+template<class Category, typename = void>
+inline constexpr bool has_constexpr_level_v = false;
+
+template<class Category>
+inline constexpr bool has_constexpr_level_v<Category, std::void_t<std::integral_constant<decltype(Category::level()), Category::level()>>> = true;
+
+// Pins category's epoch, if the category has one, for the life time of the guard.
+// The pinned flag of the statement makes nested guards no-op, so a statement pins the epoch once
+template<class Category, typename = void>
+struct sink_guard {
+    constexpr explicit sink_guard(bool&) noexcept {}
+};
+
+template<class Category>
+class sink_guard<Category, std::void_t<decltype(Category::epoch())>> {
+public:
+    explicit sink_guard(bool& pinned) noexcept : pinned_ { pinned ? nullptr : &pinned } {
+        if (pinned_ == nullptr) return;
+        ticket_ = Category::epoch().enter();
+        *pinned_ = true;
+    }
+    sink_guard(const sink_guard&) = delete;
+    sink_guard(sink_guard&&) = delete;
+    sink_guard& operator=(const sink_guard&) = delete;
+    sink_guard& operator=(sink_guard&&) = delete;
+    ~sink_guard() {
+        if (pinned_ == nullptr) return;
+        Category::epoch().leave(ticket_);
+        *pinned_ = false;
+    }
+private:
+    bool* pinned_;
+    unsigned ticket_ {};
+};
+
+// Configuration generation, advanced on any change of a run-time level or sink.
+// Categories compare it with the generation of their resolved settings to detect changes in the hierarchy
+inline std::atomic<std::uint64_t> config_generation { 1 };
+
+inline std::uint64_t generation() noexcept {
+    return config_generation.load(std::memory_order_relaxed);
+}
+
+inline void advance_generation() noexcept {
+    config_generation.fetch_add(1, std::memory_order_release);
+}
+
+// Message sequence numbers, taken by threads in batches to avoid contention on the shared counter.
+// Numbers are unique and increasing within a thread, across threads they are only roughly ordered
+class sequence {
+public:
+    static constexpr std::uint64_t batch = 1024;
+    static std::uint64_t next() noexcept {
+        if (range_.next == range_.end) {
+            range_.next = next_.fetch_add(batch, std::memory_order_relaxed);
+            range_.end = range_.next + batch;
+        }
+        return range_.next++;
+    }
+private:
+    struct range {
+        std::uint64_t next;
+        std::uint64_t end;
+    };
+    static inline std::atomic<std::uint64_t> next_ { 1 };
+    static inline thread_local range range_ {};
+};
+
+// Logging performance counters, maintained per thread and summed up on request
+enum class counter : unsigned {
+    messages,   // messages passed to writers
+    bytes,      // bytes passed to writers
+    truncated,  // messages truncated due to the length limit
+    suppressed, // messages suppressed by limiters
+    count_
+};
+
+class counters {
+public:
+    static constexpr auto size = static_cast<std::size_t>(counter::count_);
+    static constexpr std::string_view names[size] { "messages", "bytes", "truncated", "suppressed" };
+    using values = std::array<std::uint64_t, size>;
+    // Only the owning thread modifies its counters, so no read-modify-write is needed
+    static void add(counter c, std::uint64_t value = 1) noexcept {
+        auto& v { slab_.values[static_cast<std::size_t>(c)] };
+        v.store(v.load(std::memory_order_relaxed) + value, std::memory_order_relaxed);
+    }
+    static values snapshot() noexcept {
+        std::lock_guard<std::mutex> lock { mutex() };
+        values result { retired() };
+        for (auto s { head() }; s != nullptr; s = s->next) {
+            for (std::size_t i = 0; i < size; ++i) result[i] += s->values[i].load(std::memory_order_relaxed);
+        }
+        return result;
+    }
+private:
+    struct slab {
+        slab() noexcept {
+            std::lock_guard<std::mutex> lock { mutex() };
+            next = head();
+            head() = this;
+        }
+        slab(const slab&) = delete;
+        slab(slab&&) = delete;
+        slab& operator=(const slab&) = delete;
+        slab& operator=(slab&&) = delete;
+        ~slab() {
+            std::lock_guard<std::mutex> lock { mutex() };
+            for (std::size_t i = 0; i < size; ++i) retired()[i] += values[i].load(std::memory_order_relaxed);
+            for (auto p { &head() }; *p != nullptr; p = &(*p)->next) {
+                if (*p == this) {
+                    *p = next;
+                    break;
+                }
+            }
+        }
+        std::array<std::atomic<std::uint64_t>, size> values {};
+        slab* next {};
+    };
+    // function-local statics are used for safe access from thread exit at process termination
+    static std::mutex& mutex() noexcept { static std::mutex instance {}; return instance; }
+    static slab*& head() noexcept { static slab* instance {}; return instance; }
+    static values& retired() noexcept { static values instance {}; return instance; }
+    static inline thread_local slab slab_ {};
+};
+
+} // namespace logovod::detail
@@ -0,0 +1,140 @@
+/*
+ * Copyright (C) 2024 Eugene Hutorny <eugene@hutorny.in.ua>
+ *
+ * This file is a part of logovod library
+ *
+ * Licensed under MIT License, see full text in LICENSE
+ * or visit page https://opensource.org/license/mit/
+ */
+
+#pragma once
+#include <logovod/config.h>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+
+// Adaptive load shedding. The governor tracks write latency and queue depth, reported by sinks, and, when either
+// crosses its high threshold, caps levels of shed_level categories, dropping their low priority statements.
+// The cap is lifted when both fall below their low thresholds. Transitions are logged with the logovod.shedding category
+namespace logovod::shedding {
+
+struct thresholds {
+    std::chrono::nanoseconds latency_high { std::chrono::milliseconds { 1 } };
+    std::chrono::nanoseconds latency_low { std::chrono::microseconds { 100 } };
+    std::size_t depth_high { 1000 };
+    std::size_t depth_low { 100 };
+    // level, the categories are capped at
+    priority level { priority::notice };
+};
+
+struct metrics {
+    // exponentially weighted moving average of write latency
+    std::chrono::nanoseconds latency;
+    std::size_t depth;
+    bool shedding;
+    std::uint64_t transitions;
+};
+
+struct events : runtime_sink<events, runtime_level<events, category>> {
+    static constexpr std::string_view tag = "logovod.shedding";
+};
+
+class governor {
+public:
+    // Sets thresholds and resets the state
+    static void configure(const thresholds& t) noexcept {
+        latency_high_.store(t.latency_high.count(), std::memory_order_relaxed);
+        latency_low_.store(t.latency_low.count(), std::memory_order_relaxed);
+        depth_high_.store(t.depth_high, std::memory_order_relaxed);
+        depth_low_.store(t.depth_low, std::memory_order_relaxed);
+        level_.store(t.level, std::memory_order_relaxed);
+        latency_.store(0, std::memory_order_relaxed);
+        depth_.store(0, std::memory_order_relaxed);
+        transition(false);
+    }
+    // Reports duration of a write
+    static void latency(std::chrono::nanoseconds value) noexcept {
+        // concurrent reports are all accounted, none is lost between the load and the store
+        auto average { latency_.load(std::memory_order_relaxed) };
+        while (!latency_.compare_exchange_weak(average, average + (value.count() - average) / weight,
+                                               std::memory_order_relaxed)) {}
+        update();
+    }
+    // Reports depth of a queue
+    static void depth(std::size_t value) noexcept {
+        depth_.store(value, std::memory_order_relaxed);
+        update();
+    }
+    // Level cap for shed_level categories, debug when not shedding
+    static priority cap() noexcept { return cap_.load(std::memory_order_relaxed); }
+    static metrics snapshot() noexcept {
+        return {
+            std::chrono::nanoseconds { latency_.load(std::memory_order_relaxed) },
+            depth_.load(std::memory_order_relaxed),
+            shedding_.load(std::memory_order_relaxed),
+            transitions_.load(std::memory_order_relaxed)
+        };
+    }
+private:
+    static constexpr std::int64_t weight = 8;
+    static void update() noexcept {
+        const auto latency { latency_.load(std::memory_order_relaxed) };
+        const auto depth { depth_.load(std::memory_order_relaxed) };
+        if (shedding_.load(std::memory_order_relaxed)) {
+            if (latency < latency_low_.load(std::memory_order_relaxed) && depth < depth_low_.load(std::memory_order_relaxed)) {
+                transition(false);
+            }
+        } else if (latency > latency_high_.load(std::memory_order_relaxed) || depth > depth_high_.load(std::memory_order_relaxed)) {
+            transition(true);
+        }
+    }
+    static void transition(bool shedding) noexcept {
+        if (shedding_.exchange(shedding, std::memory_order_acq_rel) == shedding) return;
+        const auto level { shedding ? level_.load(std::memory_order_relaxed) : priority::debug };
+        cap_.store(level, std::memory_order_relaxed);
+        transitions_.fetch_add(1, std::memory_order_relaxed);
+        detail::advance_generation();
+        const auto m { snapshot() };
+        logger<events>::log(shedding ? priority::warning : priority::notice,
+            shedding ? "load shedding started, level capped at" : "load shedding stopped, level restored to",
+            config::level_name(level), "latency", m.latency.count(), "ns depth", m.depth);
+    }
+    static inline std::atomic<std::int64_t> latency_high_ { thresholds {}.latency_high.count() };
+    static inline std::atomic<std::int64_t> latency_low_ { thresholds {}.latency_low.count() };
+    static inline std::atomic<std::size_t> depth_high_ { thresholds {}.depth_high };
+    static inline std::atomic<std::size_t> depth_low_ { thresholds {}.depth_low };
+    static inline std::atomic<priority> level_ { thresholds {}.level };
+    static inline std::atomic<std::int64_t> latency_ {};
+    static inline std::atomic<std::size_t> depth_ {};
+    static inline std::atomic<bool> shedding_ {};
+    static inline std::atomic<priority> cap_ { priority::debug };
+    static inline std::atomic<std::uint64_t> transitions_ {};
+};
+
+} // namespace logovod::shedding
+
+namespace logovod {
+
+// Run-time configurable level, capped by the load shedding governor
+template<class Category, class Base>
+struct shed_level : runtime_level<Category, Base> {
+    using runtime_level<Category, Base>::level;
+    static priority level() noexcept {
+        const auto level { runtime_level<Category, Base>::level() };
+        const auto cap { shedding::governor::cap() };
+        return level < cap ? level : cap;
+    }
+};
+
+namespace sink {
+// Writes with the Writer, reporting the write latency to the load shedding governor
+template<auto Writer>
+void metered(std::string_view message, std::string_view payload, attributes attrs) noexcept {
+    using clock = std::chrono::steady_clock;
+    const auto start { clock::now() };
+    Writer(message, payload, attrs);
+    shedding::governor::latency(clock::now() - start);
+}
+} // namespace sink
+
+} // namespace logovod
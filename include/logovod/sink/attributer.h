@@ -10,8 +10,13 @@
 #pragma once
 
 #include <logovod/core.h>
+#include <logovod/clock.h>
+#include <logovod/thread.h>
+#include <algorithm>
+#include <charconv>
 #include <chrono>
 #include <filesystem>
+#include <iterator>
 
 namespace logovod::sink {
 namespace prolog {
@@ -22,6 +27,16 @@ struct prolog_traits {
     static constexpr unsigned filename_field_width = 16;
     static constexpr unsigned linenum_field_width = 4;
     static constexpr bool print_location = true;
+    static constexpr bool print_context = true;
+    // thread name, or id if not named, and process id, cached per thread
+    static constexpr bool print_thread = false;
+    static constexpr bool print_pid = false;
+    // sequence and part numbers of messages written in parts, see category::chunked
+    static constexpr bool print_part = true;
+    // time source of the time stamp, used when not captured by the emitter
+    using clock = logovod::clock::system;
+    static constexpr time_precision precision = time_precision::milliseconds;
+    static constexpr bool utc = false;
     static constexpr auto level_name(priority level) noexcept {
         constexpr const char* names[] = { "EMERGENCY", "ALERT    ", "CRITICAL ", "ERROR    ",
                                           "WARNING  ", "NOTICE   ", "INFO     ", "DEBUG    "};
@@ -35,18 +50,48 @@ struct prolog_traits {
     }
 };
 
+// Writes the text left aligned in the field of the given width, without changing the stream format
+inline void put_padded(std::ostream& out, std::string_view text, std::size_t width) {
+    out.write(text.data(), static_cast<std::streamsize>(text.size()));
+    for (auto size { text.size() }; size < width; ++size) out.put(' ');
+}
+
+// Marks records of a message written in parts with its sequence and part numbers, '+' tells more parts follow:
+// #1025.0+|
+template<typename Traits>
+void put_part(std::ostream& out, attributes attrs) {
+    if (!Traits::print_part || (attrs.part == 0 && !attrs.continued)) return;
+    char number[20];
+    auto end { std::to_chars(std::begin(number), std::end(number), attrs.sequence).ptr };
+    out.put('#').write(number, end - number).put('.');
+    end = std::to_chars(std::begin(number), std::end(number), attrs.part).ptr;
+    out.write(number, end - number);
+    if (attrs.continued) out.put('+');
+    out.put(Traits::field_delimiter);
+}
+
 template<typename Traits = prolog_traits>
 void common(std::ostream& out, attributes attrs) noexcept {
-    logovod::detail::put_time_point(out, std::chrono::system_clock::now())
-        << Traits::field_delimiter
-        << std::setw(Traits::tag_field_width) << std::left
-        << attrs.tag
-        << Traits::field_delimiter
+    // the time stamp captured by the emitter, if the category has a time source
+    const auto time { attrs.time.empty() ? Traits::clock::now() : attrs.time };
+    logovod::detail::time_renderer::print(out, time.to_sys(), Traits::precision, Traits::utc)
+        << Traits::field_delimiter;
+    if (Traits::print_pid) {
+        put_padded(out, logovod::detail::thread_fragments::pid(), 0);
+        out.put(Traits::field_delimiter);
+    }
+    if (Traits::print_thread) {
+        put_padded(out, logovod::detail::thread_fragments::name(), 0);
+        out.put(Traits::field_delimiter);
+    }
+    put_padded(out, attrs.tag, Traits::tag_field_width);
+    out << Traits::field_delimiter
         << Traits::level_name(attrs.level)
         << Traits::field_delimiter;
     if (Traits::print_location) {
         if (attrs.location.line != 0)
             out << std::setw(Traits::filename_field_width)
+                << std::left
                 << Traits::basename(attrs.location.file_name) << ':'
                 << std::setw(Traits::linenum_field_width)
                 << std::left
@@ -60,6 +105,100 @@ void common(std::ostream& out, attributes attrs) noexcept {
                 << std::setfill('-') << '-'
                 << Traits::field_delimiter;
     }
+    if (Traits::print_context && !attrs.context.empty()) {
+        const auto text { attrs.context.text() };
+        out.write(text.data(), static_cast<std::streamsize>(text.size())) << Traits::field_delimiter;
+    }
+    put_part<Traits>(out, attrs);
+}
+
+namespace detail {
+// Parts of the common prolog known at compile time: the padded category tag with level names,
+// and the location placeholder for statements without source location
+template<class Category, class Traits>
+struct fragments {
+    static constexpr std::size_t level_name_size() noexcept {
+        std::size_t size {};
+        for (int level {}; level <= static_cast<int>(priority::debug) + 1; ++level)
+            size = std::max(size, std::string_view { Traits::level_name(static_cast<priority>(level)) }.size());
+        return size;
+    }
+    // the longest of the fragments, the tag with a level name or the location placeholder, with their delimiters
+    static constexpr std::size_t capacity = std::max(
+        std::max<std::size_t>(Category::tag.size(), Traits::tag_field_width) + level_name_size() + 2,
+        std::max<std::size_t>(Traits::filename_field_width, 1) + std::max<std::size_t>(Traits::linenum_field_width, 1) + 2);
+    struct text {
+        char data[capacity];
+        std::size_t size;
+        constexpr void append(std::string_view part) noexcept {
+            for (auto c : part) data[size++] = c;
+        }
+        constexpr void append(char c, std::size_t count = 1) noexcept {
+            while (count-- != 0) data[size++] = c;
+        }
+        constexpr std::string_view view() const noexcept { return { data, size }; }
+    };
+    static constexpr text tagged(priority level) noexcept {
+        text result {};
+        result.append(Category::tag);
+        if (Category::tag.size() < Traits::tag_field_width) result.append(' ', Traits::tag_field_width - Category::tag.size());
+        result.append(Traits::field_delimiter);
+        result.append(Traits::level_name(level));
+        result.append(Traits::field_delimiter);
+        return result;
+    }
+    static constexpr text unlocated() noexcept {
+        text result {};
+        result.append('-', std::max<std::size_t>(Traits::filename_field_width, 1));
+        result.append(':');
+        result.append('-', std::max<std::size_t>(Traits::linenum_field_width, 1));
+        result.append(Traits::field_delimiter);
+        return result;
+    }
+    static constexpr text levels[] {
+        tagged(priority::emergency), tagged(priority::alert), tagged(priority::critical), tagged(priority::error),
+        tagged(priority::warning), tagged(priority::notice), tagged(priority::informational), tagged(priority::debug),
+        tagged(static_cast<priority>(static_cast<int>(priority::debug) + 1))
+    };
+    static constexpr text none { unlocated() };
+};
+} // namespace detail
+
+// Common prolog with the category tag and level names rendered at compile time,
+// the output is the same as of common<Traits>, without stream manipulators:
+// static constexpr auto prolog() noexcept { return sink::prolog::precomputed<MyCategory>; }
+template<class Category, typename Traits = prolog_traits>
+void precomputed(std::ostream& out, attributes attrs) noexcept {
+    using fragments = detail::fragments<Category, Traits>;
+    const auto time { attrs.time.empty() ? Traits::clock::now() : attrs.time };
+    logovod::detail::time_renderer::print(out, time.to_sys(), Traits::precision, Traits::utc).put(Traits::field_delimiter);
+    if (Traits::print_pid) {
+        put_padded(out, logovod::detail::thread_fragments::pid(), 0);
+        out.put(Traits::field_delimiter);
+    }
+    if (Traits::print_thread) {
+        put_padded(out, logovod::detail::thread_fragments::name(), 0);
+        out.put(Traits::field_delimiter);
+    }
+    const auto level { std::min(static_cast<std::size_t>(attrs.level), std::size(fragments::levels) - 1) };
+    put_padded(out, fragments::levels[level].view(), 0);
+    if (Traits::print_location) {
+        if (attrs.location.line != 0) {
+            put_padded(out, Traits::basename(attrs.location.file_name), Traits::filename_field_width);
+            out.put(':');
+            char line[16];
+            const auto end { std::to_chars(std::begin(line), std::end(line), attrs.location.line).ptr };
+            put_padded(out, { line, static_cast<std::size_t>(end - line) }, Traits::linenum_field_width);
+            out.put(Traits::field_delimiter);
+        } else {
+            put_padded(out, fragments::none.view(), 0);
+        }
+    }
+    if (Traits::print_context && !attrs.context.empty()) {
+        put_padded(out, attrs.context.text(), 0);
+        out.put(Traits::field_delimiter);
+    }
+    put_part<Traits>(out, attrs);
 }
 
 inline void taglvl(std::ostream& out, attributes attrs) noexcept {
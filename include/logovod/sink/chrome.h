@@ -0,0 +1,78 @@
+/*
+ * Copyright (C) 2024 Eugene Hutorny <eugene@hutorny.in.ua>
+ *
+ * This file is a part of logovod library
+ *
+ * Licensed under MIT License, see full text in LICENSE
+ * or visit page https://opensource.org/license/mit/
+ */
+
+#pragma once
+#include <logovod/span.h>
+#include <unistd.h>
+#include <fstream>
+#include <iomanip>
+#include <mutex>
+
+namespace logovod::sink {
+// Trace writer to a file in the Chrome trace event format, as complete ("X") events,
+// loadable into chrome://tracing or Perfetto. ID designates an identity
+template<unsigned ID>
+class chrome {
+public:
+    static void writer(const trace::event& e) noexcept {
+        std::lock_guard<std::mutex> lock { mutex_ };
+        if (!out.is_open()) return;
+        out << (first_ ? "\n" : ",\n") << R"({"name":")";
+        escape(e.name);
+        out << R"(","cat":")";
+        escape(e.tag);
+        out << R"(","ph":"X","ts":)";
+        put_micros(e.start.time_since_epoch());
+        out << R"(,"dur":)";
+        put_micros(e.duration);
+        out << R"(,"pid":)" << ::getpid() << R"(,"tid":)" << e.thread
+            << R"(,"args":{"id":)" << e.id << R"(,"parent":)" << e.parent << "}}";
+        first_ = false;
+    }
+    // Opens the file and starts tracing to it
+    template<typename Path>
+    static void open(const Path& path) {
+        {
+            std::lock_guard<std::mutex> lock { mutex_ };
+            out.open(path, std::ios_base::trunc);
+            out << '[';
+            first_ = true;
+        }
+        trace::writer(writer);
+    }
+    // Stops tracing and completes the file
+    static void close() {
+        trace::writer(nullptr);
+        std::lock_guard<std::mutex> lock { mutex_ };
+        out << "\n]\n";
+        out.close();
+    }
+private:
+    static void escape(std::string_view text) {
+        for (auto c : text) {
+            if (c == '"' || c == '\\') {
+                out << '\\' << c;
+            } else if (static_cast<unsigned char>(c) < 0x20) {
+                out << "\\u" << std::hex << std::setw(4) << std::setfill('0') << +c << std::dec << std::setfill(' ');
+            } else {
+                out << c;
+            }
+        }
+    }
+    // trace event times are in microseconds
+    static void put_micros(trace::clock::duration d) {
+        const auto ns { std::chrono::duration_cast<std::chrono::nanoseconds>(d).count() };
+        out << ns / 1000 << '.' << std::setw(3) << std::setfill('0') << ns % 1000 << std::setfill(' ');
+    }
+    static inline std::ofstream out {};
+    static inline std::mutex mutex_ {};
+    static inline bool first_ {};
+};
+
+} // namespace logovod::sink
@@ -0,0 +1,195 @@
+/*
+ * Copyright (C) 2024 Eugene Hutorny <eugene@hutorny.in.ua>
+ *
+ * This file is a part of logovod library
+ *
+ * Licensed under MIT License, see full text in LICENSE
+ * or visit page https://opensource.org/license/mit/
+ */
+
+#pragma once
+#include <logovod/core.h>
+#include <logovod/aggregate.h>
+#include <chrono>
+#include <cstdint>
+#include <mutex>
+#include <new>
+#include <string>
+
+namespace logovod::sink {
+namespace detail {
+// Recent payloads of several categories, written by one thread.
+// Windows are listed per Writer and TimeoutMs, so that summaries of expired bursts are written by aggregate::report,
+// the window mutex is taken by another thread only when reporting
+template<auto Writer, unsigned TimeoutMs>
+class dedup_window {
+public:
+    using string_view = writer_string_view<Writer>;
+    using char_type = typename string_view::value_type;
+    using string = std::basic_string<char_type, typename string_view::traits_type>;
+    using clock = std::chrono::steady_clock;
+    static constexpr std::size_t size = 4;
+
+    dedup_window() noexcept {
+        [[maybe_unused]] static const bool registered { (aggregate::detail::registry::add(node_), true) };
+        std::lock_guard<std::mutex> lock { windows_mutex() };
+        next_window_ = windows();
+        windows() = this;
+    }
+    dedup_window(const dedup_window&) = delete;
+    dedup_window(dedup_window&&) = delete;
+    dedup_window& operator=(const dedup_window&) = delete;
+    dedup_window& operator=(dedup_window&&) = delete;
+    ~dedup_window() {
+        {
+            std::lock_guard<std::mutex> lock { windows_mutex() };
+            auto p { &windows() };
+            while (*p != this) p = &(*p)->next_window_;
+            *p = next_window_;
+        }
+        std::lock_guard<std::mutex> lock { mutex_ };
+        for (auto& e : entries_) summarize(e);
+    }
+
+    void write(string_view message, string_view payload, attributes attrs) noexcept {
+        std::lock_guard<std::mutex> lock { mutex_ };
+        const auto now { clock::now() };
+        // bursts of other categories are summarized when they expire, not only on their next duplicate
+        expire(now, attrs.tag.data());
+        // parts of a message are never suppressed, the whole message is unlikely a repetition
+        if (attrs.part != 0 || attrs.continued) {
+            auto& e { find(attrs.tag) };
+            summarize(e);
+            clear(e);
+            Writer(message, payload, attrs);
+            return;
+        }
+        const auto hash { hash_of(payload) };
+        const auto begin { static_cast<std::size_t>(payload.data() - message.data()) };
+        auto& e { find(attrs.tag) };
+        if (e.tag == attrs.tag.data() && e.hash == hash && string_view { e.payload } == payload) {
+            if (e.count++ == 0) e.since = now;
+            e.attrs = attrs;
+            e.attrs.context = {}; // the summary may be written out of the context
+            try {
+                // the summary is written with the prolog of the last suppressed message
+                e.prolog.assign(message.substr(0, begin));
+            } catch (const std::bad_alloc&) {
+                e.prolog.clear();
+            }
+            if (now - e.since >= std::chrono::milliseconds { TimeoutMs }) summarize(e);
+            return;
+        }
+        summarize(e);
+        clear(e);
+        try {
+            // payloads are retained to tell repetitions from hash collisions
+            e.payload.assign(payload);
+            e.tag = attrs.tag.data();
+            e.hash = hash;
+            e.attrs = attrs;
+            e.attrs.context = {};
+            e.eol = !message.empty() && message.back() == char_type('\n');
+        } catch (const std::bad_alloc&) {
+            clear(e);
+        }
+        Writer(message, payload, attrs);
+    }
+private:
+    struct entry {
+        const char* tag;
+        std::uint64_t hash;
+        string payload;
+        string prolog;
+        std::uint64_t count;
+        clock::time_point since;
+        attributes attrs;
+        bool eol;
+    };
+    // Writes summaries of expired bursts of all windows
+    static void report() {
+        const auto now { clock::now() };
+        std::lock_guard<std::mutex> lock { windows_mutex() };
+        for (auto w { windows() }; w != nullptr; w = w->next_window_) {
+            std::lock_guard<std::mutex> window_lock { w->mutex_ };
+            w->expire(now, nullptr);
+        }
+    }
+    static std::mutex& windows_mutex() noexcept { static std::mutex instance {}; return instance; }
+    static dedup_window*& windows() noexcept { static dedup_window* instance {}; return instance; }
+    // Summarizes expired bursts, except the one of the tag being written
+    void expire(clock::time_point now, const char* tag) noexcept {
+        for (auto& e : entries_) {
+            if (e.count != 0 && e.tag != tag && now - e.since >= std::chrono::milliseconds { TimeoutMs }) summarize(e);
+        }
+    }
+    static std::uint64_t hash_of(string_view text) noexcept {
+        std::uint64_t hash { 0xCBF29CE484222325ull };
+        for (auto c : text) hash = (hash ^ static_cast<std::uint64_t>(c)) * 0x100000001B3ull;
+        return hash;
+    }
+    // Resets the entry, retaining capacity of its strings
+    static void clear(entry& e) noexcept {
+        e.tag = nullptr;
+        e.hash = 0;
+        e.payload.clear();
+        e.prolog.clear();
+        e.count = 0;
+        e.attrs = {};
+        e.eol = false;
+    }
+    entry& find(std::string_view tag) noexcept {
+        for (auto& e : entries_) if (e.tag == tag.data()) return e;
+        auto& e { entries_[next_++ % size] };
+        summarize(e);
+        clear(e);
+        return e;
+    }
+    void summarize(entry& e) noexcept {
+        if (e.count == 0) return;
+        constexpr std::string_view prefix { "last message repeated " };
+        constexpr std::string_view suffix { " times" };
+        char_type text[prefix.size() + 20 + suffix.size() + 1];
+        std::size_t length {};
+        for (auto c : prefix) text[length++] = char_type(c);
+        char digits[20];
+        std::size_t count {};
+        for (auto n { e.count }; n != 0 || count == 0; n /= 10) digits[count++] = static_cast<char>('0' + n % 10);
+        while (count != 0) text[length++] = char_type(digits[--count]);
+        for (auto c : suffix) text[length++] = char_type(c);
+        const string_view payload { text, length };
+        if (e.eol) text[length++] = char_type('\n');
+        e.count = 0;
+        e.since = clock::now();
+        try {
+            summary_.assign(e.prolog).append(text, length);
+        } catch (const std::bad_alloc&) {
+            // the summary is written without the prolog
+            Writer(string_view { text, length }, payload, e.attrs);
+            return;
+        }
+        const string_view message { summary_ };
+        Writer(message, message.substr(e.prolog.size(), payload.size()), e.attrs);
+    }
+    entry entries_[size] {};
+    std::size_t next_ {};
+    string summary_ {};
+    std::mutex mutex_ {};
+    dedup_window* next_window_ {};
+    static inline aggregate::detail::registry::node node_ { report, nullptr };
+};
+} // namespace detail
+
+// Writes messages with the Writer, counting consecutive identical payloads of the same category instead of writing them.
+// A summary "last message repeated N times" is written when a different payload arrives, when TimeoutMs expires since
+// the first suppressed message (checked on every write of the thread and by aggregate::report, called explicitly or
+// periodically by aggregate::reporter), or when the thread exits. The summary is written
+// with the prolog of the last suppressed message, rendered by its category with its attributes.
+// Payloads are compared by their hashes and then by their bytes, within a window of a few categories, per thread
+template<auto Writer, unsigned TimeoutMs = 1000>
+void dedup(detail::writer_string_view<Writer> message, detail::writer_string_view<Writer> payload, attributes attrs) noexcept {
+    static thread_local detail::dedup_window<Writer, TimeoutMs> window {};
+    window.write(message, payload, attrs);
+}
+
+} // namespace logovod::sink
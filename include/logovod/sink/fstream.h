@@ -26,6 +26,9 @@ public:
     static void open(const Path& path, std::ios_base::openmode mode = std::ios_base::app) {
         return out.open(path, mode);
     }
+    static void close() {
+        out.close();
+    }
 private:
     static inline std::ofstream out {};
 };
@@ -0,0 +1,76 @@
+/*
+ * Copyright (C) 2024 Eugene Hutorny <eugene@hutorny.in.ua>
+ *
+ * This file is a part of logovod library
+ *
+ * Licensed under MIT License, see full text in LICENSE
+ * or visit page https://opensource.org/license/mit/
+ */
+
+#pragma once
+#include <logovod/core.h>
+#include <cstdint>
+#include <new>
+#include <string>
+
+namespace logovod::sink {
+namespace detail {
+// Parts of the message being written by one thread
+template<auto Writer>
+class joiner {
+public:
+    using string_view = writer_string_view<Writer>;
+    using string = std::basic_string<typename string_view::value_type, typename string_view::traits_type>;
+
+    void write(string_view message, string_view payload, attributes attrs) noexcept {
+        if (attrs.part == 0 && !attrs.continued) {
+            Writer(message, payload, attrs);
+            return;
+        }
+        const auto begin { static_cast<std::size_t>(payload.data() - message.data()) };
+        try {
+            if (attrs.part == 0 && !pending_) {
+                // the prolog of the first part is the prolog of the message
+                text_.assign(message.substr(0, begin + payload.size()));
+                payload_begin_ = begin;
+                sequence_ = attrs.sequence;
+                pending_ = true;
+                return;
+            }
+            if (pending_ && attrs.sequence == sequence_) {
+                text_.append(payload);
+                if (attrs.continued) return;
+                // the epilog of the last part is the epilog of the message
+                const auto payload_size { text_.size() - payload_begin_ };
+                text_.append(message.substr(begin + payload.size()));
+                pending_ = false;
+                attrs.part = 0;
+                const string_view joined { text_ };
+                Writer(joined, joined.substr(payload_begin_, payload_size), attrs);
+                return;
+            }
+        } catch (const std::bad_alloc&) {
+            pending_ = false;
+        }
+        // parts of a message nested in the pending one, or not joined for the lack of memory
+        Writer(message, payload, attrs);
+    }
+private:
+    string text_ {};
+    std::size_t payload_begin_ {};
+    std::uint64_t sequence_ {};
+    bool pending_ {};
+};
+} // namespace detail
+
+// Writes messages, which are written in parts by chunked categories, as whole messages with the Writer.
+// Parts are joined per thread, the first part gives the prolog and the last one gives the epilog.
+// Memory is taken for the whole message, the adapter is meant for writers that need whole messages,
+// while the prolog marks parts with prolog_traits::print_part for readers of line oriented logs
+template<auto Writer>
+void joined(detail::writer_string_view<Writer> message, detail::writer_string_view<Writer> payload, attributes attrs) noexcept {
+    static thread_local detail::joiner<Writer> joiner {};
+    joiner.write(message, payload, attrs);
+}
+
+} // namespace logovod::sink
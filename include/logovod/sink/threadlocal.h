@@ -9,6 +9,7 @@
 
 #pragma once
 #include <logovod/core.h>
+#include <logovod/thread.h>
 #include <unistd.h>
 #include <fcntl.h>
 #include <filesystem>
@@ -28,7 +29,10 @@ public:
         }
     }
     static void prolog(std::ostream& out, attributes attrs) noexcept {
-        out << attrs.tag << ':' << static_cast<int>(attrs.level) << ':' << std::this_thread::get_id() << ':';
+        const auto id { logovod::detail::thread_fragments::id() };
+        out.write(attrs.tag.data(), static_cast<std::streamsize>(attrs.tag.size())).put(':')
+           .put(static_cast<char>('0' + static_cast<int>(attrs.level))).put(':')
+           .write(id.data(), static_cast<std::streamsize>(id.size())).put(':');
     }
     void operator()(std::string_view m, std::string_view pl, attributes a) const noexcept {
         writer(m, pl, a);
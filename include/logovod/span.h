@@ -0,0 +1,123 @@
+/*
+ * Copyright (C) 2024 Eugene Hutorny <eugene@hutorny.in.ua>
+ *
+ * This file is a part of logovod library
+ *
+ * Licensed under MIT License, see full text in LICENSE
+ * or visit page https://opensource.org/license/mit/
+ */
+
+#pragma once
+#include <logovod/chrono.h>
+#include <atomic>
+#include <chrono>
+
+namespace logovod {
+namespace trace {
+using clock = std::chrono::steady_clock;
+
+// Completed span, as passed to the trace writer
+struct event {
+    std::string_view name;
+    std::string_view tag;
+    clock::time_point start;
+    clock::duration duration;
+    std::uint64_t id;
+    std::uint64_t parent; // 0 for top level spans
+    std::uint32_t thread;
+};
+
+using writer_type = void (*)(const event&) noexcept;
+} // namespace trace
+
+namespace detail {
+// Trace writer receiving all completed spans, regardless of levels
+class tracer {
+public:
+    static bool active() noexcept { return writer_.load(std::memory_order_relaxed) != nullptr; }
+    static void write(const trace::event& e) noexcept {
+        const epoch::guard guard { epoch_ };
+        if (const auto writer { writer_.load(std::memory_order_acquire) }) writer(e);
+    }
+    // Returns when the previous writer is no longer in use
+    static void writer(trace::writer_type w) noexcept {
+        writer_.store(w, std::memory_order_release);
+        epoch_.synchronize();
+    }
+private:
+    static inline std::atomic<trace::writer_type> writer_ {};
+    static inline epoch epoch_ {};
+};
+
+// Thread local stack of open spans, giving parents to nested spans
+class spans {
+public:
+    static constexpr std::size_t capacity = 64;
+    // Pushes a new span and returns its id, unique across threads
+    static std::uint64_t push() noexcept {
+        const auto id { (static_cast<std::uint64_t>(thread_number()) << 32) | ++stack_.last };
+        if (stack_.depth < capacity) stack_.ids[stack_.depth] = id;
+        ++stack_.depth;
+        return id;
+    }
+    static void pop() noexcept { --stack_.depth; }
+    // Id of the span enclosing the innermost one, 0 if none or too deep
+    static std::uint64_t parent() noexcept {
+        return stack_.depth > 1 && stack_.depth - 2 < capacity ? stack_.ids[stack_.depth - 2] : 0;
+    }
+private:
+    struct stack {
+        std::uint64_t ids[capacity];
+        std::size_t depth;
+        std::uint32_t last;
+    };
+    static inline thread_local stack stack_ {};
+};
+} // namespace detail
+
+namespace trace {
+// Sets the writer for completed spans, nullptr stops tracing
+inline void writer(writer_type w) noexcept { detail::tracer::writer(w); }
+}
+
+// Measures the time of its scope and, on exit, logs the name and the duration with the given priority,
+// and passes the span to the trace writer, if any. Spans disabled by both the level and the tracer
+// do not read the clock. The name must outlive the span, e.g. a string literal:
+// span<Category> timing { "parse" };  // parse 12345ns
+template<class Category, priority Priority = priority::debug>
+class span {
+public:
+    using emitter = typename logger<Category>::template emitter<Priority>;
+    explicit span(std::string_view name, source_location&& sl = source_location::current()) noexcept
+      : name_ { name }, location_ { std::move(sl) },
+        logged_ { emitter::enabled_at(location_) }, traced_ { detail::tracer::active() } {
+        if (!logged_ && !traced_) return;
+        id_ = detail::spans::push();
+        start_ = trace::clock::now();
+    }
+    span(const span&) = delete;
+    span(span&&) = delete;
+    span& operator=(const span&) = delete;
+    span& operator=(span&&) = delete;
+    ~span() {
+        if (!logged_ && !traced_) return;
+        const auto elapsed { trace::clock::now() - start_ };
+        if (traced_) {
+            detail::tracer::write({ name_, Category::tag, start_, elapsed,
+                                    id_, detail::spans::parent(), detail::thread_number() });
+        }
+        detail::spans::pop();
+        if (logged_) emitter { location_ }(name_, elapsed);
+    }
+    // Id of the span, 0 if it is disabled
+    std::uint64_t id() const noexcept { return id_; }
+private:
+    std::string_view name_;
+    source_location location_;
+    bool logged_;
+    bool traced_;
+    std::uint64_t id_ {};
+    trace::clock::time_point start_ {};
+};
+
+} // namespace logovod
@@ -0,0 +1,189 @@
+/*
+ * Copyright (C) 2024 Eugene Hutorny <eugene@hutorny.in.ua>
+ *
+ * This file is a part of logovod library
+ *
+ * Licensed under MIT License, see full text in LICENSE
+ * or visit page https://opensource.org/license/mit/
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <iostream>
+#include <memory>
+#include <memory_resource>
+#include <new>
+#include <optional>
+#include <string_view>
+
+namespace logovod::detail {
+
+// Thread-local arena for messages spilled out of inline buffers.
+// The arena is a monotonic resource over a block retained by the thread, released when the last message
+// using it is done. The block grows to the high water mark, so spilled messages do not allocate in the steady state
+class arena {
+public:
+    static arena& local() noexcept {
+        static thread_local arena instance {};
+        return instance;
+    }
+    arena(const arena&) = delete;
+    arena(arena&&) = delete;
+    arena& operator=(const arena&) = delete;
+    arena& operator=(arena&&) = delete;
+    ~arena() = default;
+    void acquire() noexcept { ++users_; }
+    void release() noexcept {
+        if (--users_ != 0) return;
+        resource_->release();
+        if (used_ > size_) grow(used_);
+        used_ = 0;
+    }
+    // Throws std::bad_alloc, as the upstream resource does
+    void* allocate(std::size_t size, std::size_t alignment) {
+        used_ += size + alignment - 1;
+        return resource_->allocate(size, alignment);
+    }
+    // Capacity of the retained block
+    std::size_t capacity() const noexcept { return size_; }
+private:
+    arena() noexcept { resource_.emplace(std::pmr::new_delete_resource()); }
+    void grow(std::size_t size) noexcept {
+        resource_.reset();
+        block_.reset(new (std::nothrow) std::byte[size]);
+        size_ = block_ ? size : 0;
+        if (block_) {
+            resource_.emplace(block_.get(), size_, std::pmr::new_delete_resource());
+        } else {
+            resource_.emplace(std::pmr::new_delete_resource());
+        }
+    }
+    std::unique_ptr<std::byte[]> block_ {};
+    std::size_t size_ {};
+    std::size_t used_ {};
+    unsigned users_ {};
+    std::optional<std::pmr::monotonic_buffer_resource> resource_ {};
+};
+
+// Stream buffer that starts in the inline array of Size characters and spills to the thread-local arena
+// when a message overflows it, messages are truncated at Limit characters
+template<std::size_t Size, std::size_t Limit, class CharT, class Traits = std::char_traits<CharT>>
+class basic_spillbuf : public std::basic_streambuf<CharT, Traits> {
+public:
+  static_assert(Size < Limit, "Limit must exceed the inline size");
+  using base = std::basic_streambuf<CharT, Traits>;
+  using char_type = typename base::char_type;
+  using traits_type = typename base::traits_type;
+  using pos_type = typename base::pos_type;
+  using off_type = typename base::off_type;
+  using int_type = typename base::int_type;
+  using streamsize = std::streamsize;
+  basic_spillbuf() : base{} {
+    base::setp(std::begin(data_), std::end(data_));
+  }
+  basic_spillbuf(const basic_spillbuf&) = delete;
+  basic_spillbuf(basic_spillbuf&&) = delete;
+  basic_spillbuf& operator=(const basic_spillbuf&) = delete;
+  basic_spillbuf& operator=(basic_spillbuf&&) = delete;
+  ~basic_spillbuf() { unspill(); }
+  std::basic_string_view<char_type, traits_type> view() const noexcept {
+    return { base::pbase(), static_cast<std::size_t>(ppos()) };
+  }
+  // Space for writing up to size characters directly, nullptr if the space is not available
+  char_type* reserve(std::size_t size) noexcept {
+    return static_cast<std::size_t>(base::epptr() - base::pptr()) >= size ? base::pptr() : nullptr;
+  }
+  // Accounts characters written directly to the reserved space
+  void commit(char_type* end) noexcept {
+    base::pbump(static_cast<int>(end - base::pptr()));
+  }
+  inline static const pos_type npos = -1;
+  streamsize available() const noexcept {
+      return static_cast<streamsize>(Limit) - ppos();
+  }
+  // Whether the message is spilled to the arena
+  bool spilled() const noexcept { return base::pbase() != data_; }
+protected:
+  int_type overflow(int_type c) override {
+    if (traits_type::eq_int_type(c, traits_type::eof())) return traits_type::not_eof(c);
+    if (!expand(1)) return traits_type::eof();
+    *base::pptr() = traits_type::to_char_type(c);
+    base::pbump(1);
+    return c;
+  }
+  streamsize xsputn(const char_type* s, streamsize count) override {
+    const auto room { static_cast<streamsize>(base::epptr() - base::pptr()) };
+    if (count > room) expand(static_cast<std::size_t>(count));
+    const auto size { std::min(count, static_cast<streamsize>(base::epptr() - base::pptr())) };
+    traits_type::copy(base::pptr(), s, static_cast<std::size_t>(size));
+    base::pbump(static_cast<int>(size));
+    return size;
+  }
+  pos_type seekpos(pos_type pos, std::ios_base::openmode mode) override {
+    if ((std::ios_base::out & mode) == 0) return npos;
+    if (pos == pos_type(0)) unspill();
+    if(static_cast<std::size_t>(pos) > capacity()) return npos;
+    base::setp(base::pbase(), base::epptr());
+    base::pbump(static_cast<int>(pos));
+    return ppos();
+  }
+  pos_type seekoff(off_type off, std::ios_base::seekdir dir, std::ios_base::openmode mode) override {
+    if ((std::ios_base::out & mode) == 0) return npos;
+    if (dir == std::ios_base::cur) {
+      if (off == 0)
+        return ppos();
+      else {
+        if(base::pptr() + off >= base::epptr())
+          return npos;
+        base::pbump(static_cast<int>(off));
+        return ppos();
+      }
+    } else if (dir == std::ios_base::beg) {
+      return seekpos(off, mode);
+    } else if (dir == std::ios_base::end) {
+      if(static_cast<std::size_t>(off) > capacity()) return npos;
+      return seekpos(static_cast<pos_type>(capacity())-off, mode);
+    }
+    return npos;
+  }
+private:
+  pos_type ppos() const noexcept {
+    return base::pptr() - base::pbase();
+  }
+  std::size_t capacity() const noexcept {
+    return static_cast<std::size_t>(base::epptr() - base::pbase());
+  }
+  // Moves the message to a larger space in the arena, with room for more characters after the current position
+  bool expand(std::size_t more) noexcept {
+    const auto size { static_cast<std::size_t>(ppos()) };
+    if (capacity() == Limit) return false;
+    const auto required { std::min(Limit, size + more) };
+    const auto next { std::max(required, std::min(Limit, capacity() * 2)) };
+    auto& local { arena::local() };
+    if (!spilled()) local.acquire();
+    char_type* space {};
+    try {
+      space = static_cast<char_type*>(local.allocate(next * sizeof(char_type), alignof(char_type)));
+    } catch(const std::bad_alloc&) {
+      if (!spilled()) local.release();
+      return false;
+    }
+    traits_type::copy(space, base::pbase(), size);
+    base::setp(space, space + next);
+    base::pbump(static_cast<int>(size));
+    return true;
+  }
+  // Returns to the inline array, the arena space is released
+  void unspill() noexcept {
+    if (!spilled()) return;
+    base::setp(std::begin(data_), std::end(data_));
+    arena::local().release();
+  }
+  char_type data_[Size];
+};
+
+template<std::size_t Size, std::size_t Limit>
+using spillbuf = basic_spillbuf<Size, Limit, char>;
+
+} // logovod::detail
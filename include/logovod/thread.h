@@ -0,0 +1,82 @@
+/*
+ * Copyright (C) 2024 Eugene Hutorny <eugene@hutorny.in.ua>
+ *
+ * This file is a part of logovod library
+ *
+ * Licensed under MIT License, see full text in LICENSE
+ * or visit page https://opensource.org/license/mit/
+ */
+
+#pragma once
+#include <logovod/fixedbuf.h>
+#include <pthread.h>
+#include <unistd.h>
+#include <atomic>
+#include <charconv>
+#include <cstdint>
+#include <ostream>
+#include <string_view>
+#include <thread>
+
+namespace logovod::detail {
+
+// Per thread prolog fragments - thread id, thread name and process id, rendered once and copied to messages.
+// Fragments are rendered again in the child process after fork and after renaming the thread with thread_name()
+class thread_fragments {
+public:
+    // std::this_thread::get_id() as printed by operator<<
+    static std::string_view id() noexcept { const auto& c { current() }; return { c.id, c.id_size }; }
+    // Name of the thread, the id if the thread is not named or names are not available (Android before API 26)
+    static std::string_view name() noexcept { const auto& c { current() }; return { c.name, c.name_size }; }
+    static std::string_view pid() noexcept { const auto& c { current() }; return { c.pid, c.pid_size }; }
+    // Invalidates fragments of the calling thread
+    static void invalidate() noexcept { cache_.generation = 0; }
+private:
+    struct cache {
+        std::uint64_t generation;
+        char id[32];
+        char name[16];
+        char pid[16];
+        std::size_t id_size;
+        std::size_t name_size;
+        std::size_t pid_size;
+    };
+    static const cache& current() noexcept {
+        const auto generation { generation_.load(std::memory_order_relaxed) };
+        if (cache_.generation != generation) fill(cache_, generation);
+        return cache_;
+    }
+    static void fill(cache& c, std::uint64_t generation) noexcept {
+        fixedbuf<sizeof(c.id)> buffer {};
+        std::ostream out { &buffer };
+        out << std::this_thread::get_id();
+        c.id_size = buffer.view().copy(c.id, sizeof(c.id));
+        c.name_size = 0;
+#if !defined(__ANDROID__) || __ANDROID_API__ >= 26
+        // pthread_getname_np is available on Android since API 26
+        if (::pthread_getname_np(::pthread_self(), c.name, sizeof(c.name)) == 0) c.name_size = std::string_view { c.name }.size();
+#endif
+        if (c.name_size == 0) c.name_size = std::string_view { c.id, c.id_size }.copy(c.name, sizeof(c.name));
+        c.pid_size = static_cast<std::size_t>(std::to_chars(std::begin(c.pid), std::end(c.pid), ::getpid()).ptr - c.pid);
+        c.generation = generation;
+    }
+    static void forked() noexcept { generation_.fetch_add(1, std::memory_order_relaxed); }
+    static std::uint64_t initial() noexcept {
+        ::pthread_atfork(nullptr, nullptr, forked);
+        return 1;
+    }
+    static inline std::atomic<std::uint64_t> generation_ { initial() };
+    static inline thread_local cache cache_ {};
+};
+
+} // namespace logovod::detail
+
+namespace logovod {
+// Names the calling thread, for prologs printing thread names. Names longer than 15 characters are truncated
+inline void thread_name(std::string_view name) noexcept {
+    char text[16] {};
+    name.copy(text, sizeof(text) - 1);
+    ::pthread_setname_np(::pthread_self(), text);
+    detail::thread_fragments::invalidate();
+}
+} // namespace logovod
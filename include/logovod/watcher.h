@@ -0,0 +1,99 @@
+/*
+ * Copyright (C) 2024 Eugene Hutorny <eugene@hutorny.in.ua>
+ *
+ * This file is a part of logovod library
+ *
+ * Licensed under MIT License, see full text in LICENSE
+ * or visit page https://opensource.org/license/mit/
+ */
+
+#pragma once
+#include <logovod/config.h>
+#include <sys/inotify.h>
+#include <poll.h>
+#include <unistd.h>
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <filesystem>
+#include <thread>
+
+namespace logovod::config {
+
+// Watches a configuration file and reloads it when the file is written or replaced.
+// The directory of the file is watched, so that editors replacing the file are followed.
+// New settings are applied with atomic stores, logging threads are never blocked by a reload
+class watcher {
+public:
+    explicit watcher(std::filesystem::path path) : path_ { std::move(path) } {
+        if (path_.filename().empty() || ::pipe(stop_) != 0) return;
+        inotify_ = ::inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+        if (inotify_ == -1) return;
+        auto dir { path_.parent_path() };
+        if (dir.empty()) dir = ".";
+        constexpr auto mask = IN_CLOSE_WRITE | IN_MOVED_TO;
+        if (::inotify_add_watch(inotify_, dir.c_str(), mask) == -1) return;
+        reload();
+        thread_ = std::thread { [this]() { run(); } };
+    }
+    watcher(const watcher&) = delete;
+    watcher(watcher&&) = delete;
+    watcher& operator=(const watcher&) = delete;
+    watcher& operator=(watcher&&) = delete;
+    ~watcher() {
+        if (thread_.joinable()) {
+            const char stop {};
+            static_cast<void>(::write(stop_[1], &stop, 1));
+            thread_.join();
+        }
+        for (auto fd : { inotify_, stop_[0], stop_[1] }) if (fd != -1) ::close(fd);
+    }
+    // Whether the file is being watched
+    bool active() const noexcept { return thread_.joinable(); }
+    // Number of successful and failed attempts to load the file
+    unsigned reloads() const noexcept { return reloads_.load(std::memory_order_acquire); }
+    unsigned failures() const noexcept { return failures_.load(std::memory_order_acquire); }
+private:
+    void reload() {
+        if (load(path_)) {
+            reloads_.fetch_add(1, std::memory_order_release);
+        } else {
+            failures_.fetch_add(1, std::memory_order_release);
+        }
+    }
+    bool changed() noexcept {
+        alignas(inotify_event) char buffer[4096];
+        bool result {};
+        for (;;) {
+            const auto size { ::read(inotify_, buffer, sizeof(buffer)) };
+            if (size <= 0) return result;
+            for (auto pos { buffer }; pos < buffer + size; ) {
+                inotify_event event;
+                std::copy(pos, pos + sizeof(event), reinterpret_cast<char*>(&event));
+                const std::string_view name { pos + sizeof(event), event.len };
+                result = result || name.substr(0, name.find('\0')) == path_.filename().native();
+                pos += sizeof(event) + event.len;
+            }
+        }
+    }
+    void run() {
+        pollfd fds[] { { inotify_, POLLIN, 0 }, { stop_[0], POLLIN, 0 } };
+        for (;;) {
+            if (::poll(fds, 2, -1) == -1) {
+                // revents are not updated by an interrupted poll
+                if (errno == EINTR) continue;
+                return;
+            }
+            if ((fds[1].revents & POLLIN) != 0) return;
+            if ((fds[0].revents & POLLIN) != 0 && changed()) reload();
+        }
+    }
+    std::filesystem::path path_;
+    int inotify_ { -1 };
+    int stop_[2] { -1, -1 };
+    std::atomic<unsigned> reloads_ {};
+    std::atomic<unsigned> failures_ {};
+    std::thread thread_ {};
+};
+
+} // namespace logovod::config
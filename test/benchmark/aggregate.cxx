@@ -0,0 +1,29 @@
+/*
+ * Copyright (C) 2024 Eugene Hutorny <eugene@hutorny.in.ua>
+ *
+ * This file is a part of logovod library
+ *
+ * Licensed under MIT License, see full text in LICENSE
+ * or visit page https://opensource.org/license/mit/
+ */
+
+#include "benchmark.h"
+#include <logovod/aggregate.h>
+
+using namespace logovod;
+using namespace logovod::benchmarks;
+
+struct Written : category {
+    static constexpr std::string_view tag = "hot";
+    static constexpr auto writer() noexcept { return null; }
+};
+
+struct Counted : aggregated<Counted, Written> {};
+
+constexpr std::size_t iterations = 1'000'000;
+
+int main() {
+    report("written   ", "", measure(iterations, [](std::size_t i) { logger<Written>::i{}("event", i, "of", iterations); }));
+    report("aggregated", "", measure(iterations, [](std::size_t i) { logger<Counted>::i{}("event", i, "of", iterations); }));
+    return 0;
+}
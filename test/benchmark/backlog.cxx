@@ -0,0 +1,35 @@
+/*
+ * Copyright (C) 2024 Eugene Hutorny <eugene@hutorny.in.ua>
+ *
+ * This file is a part of logovod library
+ *
+ * Licensed under MIT License, see full text in LICENSE
+ * or visit page https://opensource.org/license/mit/
+ */
+
+#include "benchmark.h"
+
+using namespace logovod;
+using namespace logovod::benchmarks;
+
+struct Plain : category {
+    static constexpr priority level() noexcept { return priority::warning; }
+    static constexpr auto writer() noexcept { return null; }
+};
+
+struct Captured : Plain {
+    static constexpr std::size_t backlog() noexcept { return 64; }
+};
+
+constexpr std::size_t iterations = 1'000'000;
+
+int main() {
+    report("discarded", "", measure(iterations, [](std::size_t i) { logger<Plain>::d("request", i, "served"); }));
+    report("captured ", "", measure(iterations, [](std::size_t i) { logger<Captured>::d("request", i, "served"); }));
+    report("written  ", "", measure(iterations, [](std::size_t i) { logger<Plain>::w("request", i, "served"); }));
+    report("dumped   ", "", measure(iterations / 64, [](std::size_t i) {
+        for (std::size_t j = 0; j < 63; ++j) logger<Captured>::d("request", j, "served");
+        logger<Captured>::e("request", i, "failed");
+    }) / 64);
+    return 0;
+}
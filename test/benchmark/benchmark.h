@@ -0,0 +1,39 @@
+/*
+ * Copyright (C) 2024 Eugene Hutorny <eugene@hutorny.in.ua>
+ *
+ * This file is a part of logovod library
+ *
+ * Licensed under MIT License, see full text in LICENSE
+ * or visit page https://opensource.org/license/mit/
+ */
+
+#include <logovod/logovod.h>
+#include <chrono>
+
+#pragma once
+
+namespace logovod::benchmarks {
+
+struct Report : logovod::category {
+    static constexpr auto writer() noexcept { return logovod::sink::fd<1>; }
+};
+using Rep = logovod::logger<Report>;
+
+// Null writer, for measuring the front-end alone
+inline void null(std::string_view, std::string_view, attributes) noexcept {}
+
+// Returns average duration of a single call of the function in nanoseconds
+template<typename Function>
+double measure(std::size_t iterations, Function&& function) {
+    using namespace std::chrono;
+    const auto start { steady_clock::now() };
+    for(std::size_t i = 0; i < iterations; ++i) function(i);
+    const auto elapsed { steady_clock::now() - start };
+    return static_cast<double>(duration_cast<nanoseconds>(elapsed).count()) / static_cast<double>(iterations);
+}
+
+inline void report(std::string_view name, std::string_view variant, double ns) {
+    Rep::i(name, variant, fixed<8, 2, double>{ ns }, "ns/call");
+}
+
+} // namespace logovod::benchmarks
@@ -0,0 +1,45 @@
+/*
+ * Copyright (C) 2024 Eugene Hutorny <eugene@hutorny.in.ua>
+ *
+ * This file is a part of logovod library
+ *
+ * Licensed under MIT License, see full text in LICENSE
+ * or visit page https://opensource.org/license/mit/
+ */
+
+#include "benchmark.h"
+#include <logovod/clock.h>
+#include <sstream>
+
+using namespace logovod;
+using namespace logovod::benchmarks;
+
+constexpr std::size_t iterations = 10'000'000;
+
+template<class Source>
+void run(std::string_view name) {
+    volatile std::uint64_t sink {};
+    report(name, "now   ", measure(iterations, [&sink](std::size_t) { sink = Source::now().ticks; }));
+    const auto stamp { Source::now() };
+    report(name, "to_sys", measure(iterations / 10, [&stamp, &sink](std::size_t) {
+        sink = static_cast<std::uint64_t>(stamp.to_sys().time_since_epoch().count());
+    }));
+}
+
+int main() {
+    std::ostringstream out;
+    const auto now { std::chrono::system_clock::now() };
+    report("render", "cached", measure(iterations / 10, [&out, now](std::size_t) {
+        out.seekp(0);
+        detail::time_renderer::print(out, now, time_precision::milliseconds, false);
+    }));
+    report("render", "tm    ", measure(iterations / 10, [&out, now](std::size_t) {
+        out.seekp(0);
+        const auto t { std::chrono::system_clock::to_time_t(now) };
+        out << std::put_time(std::localtime(&t), "%FT%T.");
+    }));
+    run<clock::system>("system");
+    run<clock::coarse>("coarse");
+    run<clock::tsc>("tsc   ");
+    return 0;
+}
@@ -0,0 +1,38 @@
+/*
+ * Copyright (C) 2024 Eugene Hutorny <eugene@hutorny.in.ua>
+ *
+ * This file is a part of logovod library
+ *
+ * Licensed under MIT License, see full text in LICENSE
+ * or visit page https://opensource.org/license/mit/
+ */
+
+#include "benchmark.h"
+#include <logovod/config.h>
+
+using namespace logovod;
+using namespace logovod::benchmarks;
+
+struct Filtered : runtime_level<Filtered, category> {
+    static constexpr std::string_view tag = "net.http";
+    static constexpr auto writer() noexcept { return null; }
+};
+using Log = logger<Filtered>;
+
+constexpr std::size_t iterations = 1'000'000;
+
+void run(std::string_view variant) {
+    report("rejected", variant, measure(iterations, [](std::size_t i) { Log::d("rejected", i); }));
+    report("enabled ", variant, measure(iterations, [](std::size_t i) { Log::w("written", i); }));
+}
+
+int main() {
+    config::apply("net.*=debug");
+    run("no filters      ");
+    config::filter("tag=db level=error; tag=net.* level=warning");
+    run("two rules       ");
+    config::filter("tag=db level=error; file=*/other/* level=debug; tag=*.http file=*/benchmark/* line=1-10 level=debug; "
+        "tag=net.* level=warning");
+    run("four rules      ");
+    return 0;
+}
@@ -0,0 +1,51 @@
+/*
+ * Copyright (C) 2024 Eugene Hutorny <eugene@hutorny.in.ua>
+ *
+ * This file is a part of logovod library
+ *
+ * Licensed under MIT License, see full text in LICENSE
+ * or visit page https://opensource.org/license/mit/
+ */
+
+#include "benchmark.h"
+#include <string>
+#include <utility>
+
+using namespace logovod;
+using namespace logovod::benchmarks;
+
+struct Fixed : category {
+    static constexpr priority level() noexcept { return priority::warning; }
+    static constexpr auto writer() noexcept { return null; }
+};
+
+struct Runtime : runtime_level<Runtime, Fixed> {};
+
+// Hierarchy of optional categories, Chain<N> is N levels deep
+template<unsigned Depth>
+struct Chain : optional_all<Chain<Depth>, Chain<Depth - 1>> {};
+template<>
+struct Chain<0> : Fixed {};
+
+constexpr std::size_t iterations = 10'000'000;
+
+template<class Category>
+void run(std::string_view variant) {
+    using Log = logger<Category>;
+    volatile priority level {};
+    report("level() ", variant, measure(iterations, [&level](std::size_t) { level = Category::level(); }));
+    report("disabled", variant, measure(iterations, [](std::size_t i) { typename Log::d("ignored", i); }));
+    report("enabled ", variant, measure(iterations / 10, [](std::size_t i) { typename Log::w("written", i); }));
+}
+
+template<unsigned ... Depth>
+void run(std::integer_sequence<unsigned, Depth...>) {
+    (run<Chain<Depth + 1>>("optional depth " + std::to_string(Depth + 1)), ...);
+}
+
+int main() {
+    run<Fixed>("constexpr       ");
+    run<Runtime>("runtime_level   ");
+    run(std::make_integer_sequence<unsigned, 8>{});
+    return 0;
+}
@@ -0,0 +1,54 @@
+/*
+ * Copyright (C) 2024 Eugene Hutorny <eugene@hutorny.in.ua>
+ *
+ * This file is a part of logovod library
+ *
+ * Licensed under MIT License, see full text in LICENSE
+ * or visit page https://opensource.org/license/mit/
+ */
+
+#include "benchmark.h"
+
+using namespace logovod;
+using namespace logovod::benchmarks;
+
+struct Null : category {
+    static constexpr auto writer() noexcept { return null; }
+    static constexpr auto epilog() noexcept { return sink::epilog::null; }
+};
+using Log = logger<Null>;
+
+constexpr std::size_t iterations = 1'000'000;
+
+// Formats into a stream, reused for all iterations, for measuring the printer alone
+struct Printer {
+    template<typename ... T>
+    void operator()(const T& ... values) {
+        out.seekp(0);
+        printer(out, values...);
+    }
+    detail::fixedbuf<1024> buffer {};
+    std::ostream out { &buffer };
+    Log::printer printer { Null::range_limit(), Null::trimmed(), Null::dlm(), Null::sep() };
+};
+
+int main() {
+    const std::string_view host { "example.com" };
+    Printer print {};
+    report("printer mixed   ", "", measure(iterations, [host, &print](std::size_t i) {
+        print("connected to", host, "port", 8080, "in", i, "ms");
+    }));
+    report("printer literals", "", measure(iterations, [&print](std::size_t) {
+        print("connection", "closed", "by", "peer", "after", "idle", "timeout");
+    }));
+    report("mixed   ", "", measure(iterations, [host](std::size_t i) {
+        Log::i("connected to", host, "port", 8080, "in", i, "ms");
+    }));
+    report("literals", "", measure(iterations, [](std::size_t) {
+        Log::i("connection", "closed", "by", "peer", "after", "idle", "timeout");
+    }));
+    report("values  ", "", measure(iterations, [host](std::size_t i) {
+        Log::i(host, 8080, i, i);
+    }));
+    return 0;
+}
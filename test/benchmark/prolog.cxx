@@ -0,0 +1,32 @@
+/*
+ * Copyright (C) 2024 Eugene Hutorny <eugene@hutorny.in.ua>
+ *
+ * This file is a part of logovod library
+ *
+ * Licensed under MIT License, see full text in LICENSE
+ * or visit page https://opensource.org/license/mit/
+ */
+
+#include "benchmark.h"
+#include <logovod/sink/attributer.h>
+
+using namespace logovod;
+using namespace logovod::benchmarks;
+
+struct Common : category {
+    static constexpr std::string_view tag = "bench";
+    static constexpr auto writer() noexcept { return null; }
+    static constexpr auto prolog() noexcept { return sink::prolog::common<>; }
+};
+
+struct Precomputed : Common {
+    static constexpr auto prolog() noexcept { return sink::prolog::precomputed<Precomputed>; }
+};
+
+constexpr std::size_t iterations = 1'000'000;
+
+int main() {
+    report("common     ", "", measure(iterations, [](std::size_t i) { logger<Common>::i("request", i, "served"); }));
+    report("precomputed", "", measure(iterations, [](std::size_t i) { logger<Precomputed>::i("request", i, "served"); }));
+    return 0;
+}
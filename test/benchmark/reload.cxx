@@ -0,0 +1,117 @@
+/*
+ * Copyright (C) 2024 Eugene Hutorny <eugene@hutorny.in.ua>
+ *
+ * This file is a part of logovod library
+ *
+ * Licensed under MIT License, see full text in LICENSE
+ * or visit page https://opensource.org/license/mit/
+ */
+
+#include "benchmark.h"
+#include <logovod/watcher.h>
+#include <algorithm>
+#include <atomic>
+#include <fstream>
+#include <thread>
+#include <vector>
+
+// Measures emitting latency under 1M msg/s load while the configuration file is rewritten every 10ms
+
+using namespace logovod;
+using namespace logovod::benchmarks;
+using namespace std::chrono;
+
+struct Base : category {
+    static constexpr auto writer() noexcept { return null; }
+    static constexpr auto epilog() noexcept { return sink::epilog::null; }
+};
+
+struct Bench : runtime_sink<Bench, runtime_level<Bench, Base>> {
+    static constexpr std::string_view tag = "bench";
+};
+using Log = logger<Bench>;
+
+inline void null2(std::string_view, std::string_view, attributes) noexcept {}
+
+constexpr unsigned threads = 2;
+constexpr auto rate = 1'000'000 / threads; // messages per second per thread
+constexpr auto period = duration_cast<nanoseconds>(seconds{1}) / rate;
+constexpr auto phase = milliseconds{1000};
+constexpr std::size_t bucket_ns = 50;
+constexpr std::size_t buckets = 2000; // last bucket accumulates latencies above 100us
+
+struct histogram {
+    std::vector<std::uint64_t> counts = std::vector<std::uint64_t>(buckets);
+    std::uint64_t total {};
+    nanoseconds max {};
+    void add(nanoseconds latency) {
+        const auto bucket { static_cast<std::size_t>(latency.count()) / bucket_ns };
+        counts[std::min(bucket, buckets - 1)]++;
+        max = std::max(max, latency);
+        total++;
+    }
+    void merge(const histogram& that) {
+        for (std::size_t i = 0; i < buckets; ++i) counts[i] += that.counts[i];
+        max = std::max(max, that.max);
+        total += that.total;
+    }
+    std::size_t percentile(double p) const {
+        const auto limit { static_cast<std::uint64_t>(static_cast<double>(total) * p) };
+        std::uint64_t sum {};
+        for (std::size_t i = 0; i < buckets; ++i) if ((sum += counts[i]) >= limit) return (i + 1) * bucket_ns;
+        return buckets * bucket_ns;
+    }
+};
+
+static void run(std::atomic<bool>& stop, histogram& result) {
+    auto deadline { steady_clock::now() };
+    for (std::uint64_t i = 0; !stop.load(std::memory_order_relaxed); ++i) {
+        const auto start { steady_clock::now() };
+        Log::i("message", i);
+        result.add(duration_cast<nanoseconds>(steady_clock::now() - start));
+        deadline += period;
+        while (steady_clock::now() < deadline);
+    }
+}
+
+static histogram measure(bool reconfigure, const std::filesystem::path& path) {
+    std::atomic<bool> stop {};
+    std::vector<histogram> results(threads);
+    std::vector<std::thread> workers {};
+    for (auto& result : results) workers.emplace_back(run, std::ref(stop), std::ref(result));
+    unsigned reloads {};
+    const auto finish { steady_clock::now() + phase };
+    while (steady_clock::now() < finish) {
+        std::this_thread::sleep_for(milliseconds{10});
+        if (reconfigure) {
+            std::ofstream{ path } << ((++reloads & 1) ? "bench=debug>null2\n" : "bench=info>null1\n");
+        }
+    }
+    stop = true;
+    for (auto& worker : workers) worker.join();
+    histogram total {};
+    for (auto& result : results) total.merge(result);
+    return total;
+}
+
+static void report(std::string_view name, const histogram& h) {
+    Rep::i(name, "messages", h.total, "p50", h.percentile(0.5), "p99", h.percentile(0.99),
+        "p99.9", h.percentile(0.999), "p99.99", h.percentile(0.9999), "max", h.max.count());
+}
+
+int main() {
+    const auto dir { std::filesystem::temp_directory_path() / "logovod-reload-benchmark" };
+    std::filesystem::create_directories(dir);
+    const auto path { dir / "log.conf" };
+    std::ofstream{ path } << "bench=info>null1\n";
+    config::add_sink("null1", { nullptr, null, nullptr });
+    config::add_sink("null2", { nullptr, null2, nullptr });
+    config::watcher watcher { path };
+    Log::i("warm up");
+    Rep::i("emitting latency percentiles in ns at", threads * rate, "msg/s");
+    report("steady     ", measure(false, path));
+    report("reconfigure", measure(true, path));
+    Rep::i("reloads", watcher.reloads(), "failures", watcher.failures());
+    std::filesystem::remove_all(dir);
+    return 0;
+}
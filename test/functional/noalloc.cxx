@@ -16,6 +16,22 @@ struct Category : logovod::category {
 };
 using Log = logovod::logger<Category>;
 
+struct Spilled : Category {
+    static constexpr std::size_t length_limit = 64;
+    static constexpr std::size_t spill_limit = 4096;
+};
+using Spill = logovod::logger<Spilled>;
+
+static constexpr char text[] = "Spilled message, it does not fit into the inline buffer of sixty four characters";
+
+// Messages overflowing the inline buffer reuse the thread-local arena
+static bool spill(size_t uordblks, const char* progname) {
+    for (int i = 0; i < 4; ++i) Spill::i(text, progname, text, i);
+    const auto steady = mallinfo2();
+    Log::i("Delta uordblks spilled        :", steady.uordblks - uordblks);
+    return steady.uordblks == uordblks;
+}
+
 static bool test(size_t uordblks, const char* progname) {
     Log::i("This is a simple mallinfo2 test. Use valgrind for better precision:");
     Log::i("valgrind --tool=massif --threshold=0.0", progname);
@@ -29,8 +45,10 @@ static bool test(size_t uordblks, const char* progname) {
 }
 
 int main(int, char *argv[]) {
+    // thread-local state is set up on the first use, once per thread, the spill arena grows to the message size
+    Spill::i(text, argv[0], text, 0);
     const auto onstart = mallinfo2();
-    const bool success = test(onstart.uordblks, argv[0]);
+    const bool success = test(onstart.uordblks, argv[0]) && spill(onstart.uordblks, argv[0]);
     const auto onfinish = mallinfo2();
     {
         Log::i("Delta uordblks on finish      :", onfinish.uordblks - onstart.uordblks);
@@ -0,0 +1,112 @@
+/*
+ * Copyright (C) 2024 Eugene Hutorny <eugene@hutorny.in.ua>
+ *
+ * This file is a part of logovod library
+ *
+ * Licensed under MIT License, see full text in LICENSE
+ * or visit page https://opensource.org/license/mit/
+ */
+
+#include "tests.h"
+#if __has_include(<sys/un.h>)
+#include <logovod/admin.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <thread>
+
+using namespace logovod::tests;
+using namespace logovod;
+
+namespace {
+std::string request(const std::string& path, std::string_view command) {
+    sockaddr_un address {};
+    address.sun_family = AF_UNIX;
+    path.copy(address.sun_path, sizeof(address.sun_path) - 1);
+    const int fd { ::socket(AF_UNIX, SOCK_STREAM, 0) };
+    if (::connect(fd, reinterpret_cast<const sockaddr*>(&address), sizeof(address)) != 0) {
+        ::close(fd);
+        return "error: connect";
+    }
+    static_cast<void>(::write(fd, command.data(), command.size()));
+    ::shutdown(fd, SHUT_WR);
+    std::string result;
+    char buffer[256];
+    for (ssize_t size; (size = ::read(fd, buffer, sizeof(buffer))) > 0; ) result.append(buffer, static_cast<std::size_t>(size));
+    ::close(fd);
+    return result;
+}
+}
+
+TEST_F(Config, AdminListed) {
+    config::add_sink("local", { nullptr, [](std::string_view msg, std::string_view, attributes) noexcept { local = msg; }, nullptr });
+    EXPECT_TRUE(config::apply("net.http=warning routed=>local"));
+    const auto list { admin::execute("list") };
+    EXPECT_NE(list.find("net.http warning custom\n"), list.npos);
+    EXPECT_NE(list.find("net.tcp debug custom\n"), list.npos);
+    EXPECT_NE(list.find("db.cache error custom\n"), list.npos);
+    EXPECT_NE(list.find("routed error local\n"), list.npos);
+}
+
+TEST_F(Config, AdminChanged) {
+    EXPECT_EQ(admin::execute("level net.* notice"), "ok\n");
+    EXPECT_EQ(Http::level(), priority::notice);
+    EXPECT_EQ(Tcp::level(), priority::notice);
+    EXPECT_EQ(admin::execute("level db verbose").substr(0, 6), "error:");
+    EXPECT_EQ(admin::execute("level db").substr(0, 6), "error:");
+    EXPECT_EQ(Db::level(), priority::debug);
+    const auto site { source_location::current() };
+    const auto target { "admin.cxx:" + std::to_string(site.line()) };
+    EXPECT_EQ(admin::execute("site " + target + " debug"), "ok\n");
+    H::d(site, "enabled");                      EXPECT_EQ(message, "enabled");
+    H::d("ignored");                            EXPECT_EQ(message, "enabled");
+    EXPECT_NE(admin::execute("config").find("@" + target + "=debug"), std::string::npos);
+    EXPECT_EQ(admin::execute("unknown").substr(0, 6), "error:");
+}
+
+TEST_F(Config, AdminCounted) {
+    const auto before { detail::counters::snapshot() };
+    H::i("counted");
+    const auto after { detail::counters::snapshot() };
+    EXPECT_EQ(after[0] - before[0], 1);
+    EXPECT_EQ(after[1] - before[1], message.size());
+    const auto stats { admin::execute("stats") };
+    EXPECT_NE(stats.find("messages "), stats.npos);
+    EXPECT_NE(stats.find("truncated "), stats.npos);
+}
+
+TEST_F(Config, AdminServed) {
+    const auto path { "/tmp/logovod-admin-" + std::to_string(::getpid()) };
+    {
+        admin::server server { path };
+        ASSERT_TRUE(server.active());
+        EXPECT_EQ(request(path, "level net.tcp error\n"), "ok\n");
+        EXPECT_EQ(Tcp::level(), priority::error);
+        EXPECT_NE(request(path, "list\n").find("net.tcp error custom\n"), std::string::npos);
+        EXPECT_EQ(server.served(), 2);
+    }
+    EXPECT_EQ(::access(path.c_str(), F_OK), -1);
+}
+
+TEST_F(Config, AdminRestricted) {
+    using namespace std::chrono;
+    const auto path { "/tmp/logovod-admin-" + std::to_string(::getpid()) };
+    const int fd { ::socket(AF_UNIX, SOCK_STREAM, 0) };
+    auto started { steady_clock::now() };
+    {
+        admin::server server { path };
+        ASSERT_TRUE(server.active());
+        struct stat status {};
+        ASSERT_EQ(::stat(path.c_str(), &status), 0);
+        EXPECT_EQ(status.st_mode & 0777, 0600);
+        // a client that never sends the command does not hold the server on destruction
+        sockaddr_un address {};
+        address.sun_family = AF_UNIX;
+        path.copy(address.sun_path, sizeof(address.sun_path) - 1);
+        ASSERT_EQ(::connect(fd, reinterpret_cast<const sockaddr*>(&address), sizeof(address)), 0);
+        std::this_thread::sleep_for(milliseconds { 20 });
+        started = steady_clock::now();
+    }
+    EXPECT_LT(steady_clock::now() - started, milliseconds { 500 });
+    ::close(fd);
+}
+#endif
@@ -0,0 +1,43 @@
+/*
+ * Copyright (C) 2024 Eugene Hutorny <eugene@hutorny.in.ua>
+ *
+ * This file is a part of logovod library
+ *
+ * Licensed under MIT License, see full text in LICENSE
+ * or visit page https://opensource.org/license/mit/
+ */
+
+#include "tests.h"
+
+using namespace logovod::tests;
+using namespace logovod;
+
+TEST_F(Aggregate, Counted) {
+    const auto line { std::to_string(__LINE__ + 1) };
+    for (int i = 0; i < 10; ++i) H::i{}("event", i);
+    EXPECT_EQ(write_count, 0);
+    aggregate::report();
+    EXPECT_EQ(write_count, 1);
+    EXPECT_EQ(attrs.tag, "hot");
+    EXPECT_EQ(attrs.level, priority::informational);
+    EXPECT_NE(payload.find(std::string { __FILE__ } + ":" + line + " fired 10 times in "), std::string::npos);
+    EXPECT_NE(payload.find("ms, last: event 8"), std::string::npos);
+    for (int i = 0; i < 3; ++i) H::w{}("other", i);
+    aggregate::report();
+    EXPECT_EQ(write_count, 2);
+    EXPECT_NE(payload.find(" fired 3 times in "), std::string::npos);
+    EXPECT_NE(payload.find("ms, last: other 0"), std::string::npos);
+    aggregate::report();
+    EXPECT_EQ(write_count, 2);
+}
+
+TEST_F(Aggregate, Reported) {
+    {
+        aggregate::reporter reporter { std::chrono::hours { 1 } };
+        for (int i = 0; i < 5; ++i) H::d{}("reported", i);
+    }
+    EXPECT_EQ(write_count, 1);
+    EXPECT_EQ(attrs.level, priority::debug);
+    EXPECT_NE(payload.find(" fired 5 times in "), std::string::npos);
+    EXPECT_NE(payload.find("ms, last: reported 4"), std::string::npos);
+}
@@ -8,6 +8,8 @@
  */
 
 #include "tests.h"
+#include <thread>
+#include <sys/wait.h>
 
 using namespace logovod::tests;
 using namespace logovod;
@@ -56,3 +58,106 @@ TEST_F(Attributes, Level) {
     A::alert{}("test");         EXPECT_EQ(attrs.level, priority::alert);
     A::emergency{}("test");     EXPECT_EQ(attrs.level, priority::emergency);
 }
+
+TEST_F(Attributes, Captured) {
+    using namespace std::chrono;
+    A::i("untimed");            EXPECT_TRUE(attrs.time.empty());
+    const auto before { system_clock::now() };
+    T::i("timed");
+    EXPECT_FALSE(attrs.time.empty());
+    EXPECT_GE(attrs.time.to_sys(), before);
+    EXPECT_LE(attrs.time.to_sys(), system_clock::now());
+    const auto first { attrs };
+    T::i{} << "streamed" << 1 << 2;
+    EXPECT_EQ(attrs.sequence, first.sequence + 1);
+    EXPECT_EQ(attrs.thread, first.thread);
+    EXPECT_GE(attrs.time.ticks, first.time.ticks);
+}
+
+TEST_F(Attributes, Threads) {
+    A::i("main");
+    const auto main { attrs };
+    std::thread { []() { A::i("other"); } }.join();
+    EXPECT_NE(attrs.thread, main.thread);
+    EXPECT_NE(attrs.sequence, main.sequence);
+}
+
+TEST_F(Attributes, Fragments) {
+    std::ostringstream id;
+    id << std::this_thread::get_id();
+    EXPECT_EQ(detail::thread_fragments::id(), id.str());
+    EXPECT_EQ(detail::thread_fragments::pid(), std::to_string(::getpid()));
+    std::string other;
+    std::thread { [&other]() {
+        thread_name("worker-thread-with-long-name");
+        other = detail::thread_fragments::name();
+    } }.join();
+    EXPECT_EQ(other, "worker-thread-w");
+    EXPECT_NE(detail::thread_fragments::name(), other);
+    const auto child { ::fork() };
+    if (child == 0) ::_exit(detail::thread_fragments::pid() == std::to_string(::getpid()) ? 0 : 1);
+    int status {};
+    ::waitpid(child, &status, 0);
+    EXPECT_TRUE(WIFEXITED(status) && WEXITSTATUS(status) == 0);
+}
+
+namespace {
+struct FragmentsTraits : sink::prolog::prolog_traits {
+    static constexpr bool print_thread = true;
+    static constexpr bool print_pid = true;
+};
+}
+
+TEST_F(Attributes, FragmentsProlog) {
+    std::ostringstream out;
+    sink::prolog::common<FragmentsTraits>(out, { priority::notice, "tag", {}, {} });
+    const auto expected { "|" + std::to_string(::getpid()) + "|" + std::string { detail::thread_fragments::name() } + "|tag     |NOTICE   |" };
+    EXPECT_NE(out.str().find(expected), std::string::npos);
+}
+
+TEST_F(Attributes, Precomputed) {
+    const clock::timestamp time { 1709880066977543219, clock::system::to_sys };
+    for (auto level : { priority::emergency, priority::warning, priority::debug, static_cast<priority>(9) }) {
+        for (std::uint_least32_t line : { 0u, 7u, 12345u }) {
+            const attributes a { level, "A", { "/src/some/file.cxx", line }, {}, time, 1, 1 };
+            std::ostringstream expected, actual;
+            sink::prolog::common<>(expected, a);
+            sink::prolog::precomputed<CategoryA>(actual, a);
+            EXPECT_EQ(actual.str(), expected.str());
+        }
+    }
+    const attributes a { priority::error, "A", { "a-very-long-file-name.cxx", 1 }, {}, time, 1, 1 };
+    std::ostringstream expected, actual;
+    sink::prolog::common<FragmentsTraits>(expected, a);
+    sink::prolog::precomputed<CategoryA, FragmentsTraits>(actual, a);
+    EXPECT_EQ(actual.str(), expected.str());
+}
+
+TEST_F(Attributes, PrecomputedLongTag) {
+    const clock::timestamp time { 1709880066977543219, clock::system::to_sys };
+    for (auto level : { priority::emergency, priority::informational, static_cast<priority>(9) }) {
+        const attributes a { level, LongTag::tag, { "file.cxx", 1 }, {}, time, 1, 1 };
+        std::ostringstream expected, actual;
+        sink::prolog::common<>(expected, a);
+        sink::prolog::precomputed<LongTag>(actual, a);
+        EXPECT_EQ(actual.str(), expected.str());
+        EXPECT_NE(actual.str().find(LongTag::tag), std::string::npos);
+    }
+}
+
+TEST_F(Attributes, Parts) {
+    const clock::timestamp time { 1709880066977543219, clock::system::to_sys };
+    attributes a { priority::error, "A", { "file.cxx", 1 }, {}, time, 1, 1025 };
+    for (auto [part, continued, mark] : { std::tuple { 0u, false, "" }, { 0u, true, "|#1025.0+|" }, { 3u, false, "|#1025.3|" } }) {
+        a.part = part;
+        a.continued = continued;
+        std::ostringstream expected, actual;
+        sink::prolog::common<>(expected, a);
+        sink::prolog::precomputed<CategoryA>(actual, a);
+        EXPECT_EQ(actual.str(), expected.str());
+        EXPECT_EQ(expected.str().find('#') != std::string::npos, *mark != '\0');
+        if (*mark != '\0') {
+            EXPECT_EQ(expected.str().substr(expected.str().size() - std::string_view { mark }.size()), mark);
+        }
+    }
+}
@@ -0,0 +1,60 @@
+/*
+ * Copyright (C) 2024 Eugene Hutorny <eugene@hutorny.in.ua>
+ *
+ * This file is a part of logovod library
+ *
+ * Licensed under MIT License, see full text in LICENSE
+ * or visit page https://opensource.org/license/mit/
+ */
+
+#include "tests.h"
+#include <thread>
+
+using namespace logovod::tests;
+using namespace logovod;
+
+TEST_F(Backlog, Captured) {
+    B::d("debug", 1);
+    B::i("info", 2);
+    EXPECT_EQ(write_count, 0);
+    EXPECT_EQ(detail::backlog<Captured>::size(), 2);
+    B::w("warning");
+    EXPECT_EQ(write_count, 1);
+    B::e("error");
+    EXPECT_EQ(messages, (std::vector<std::string> { "warning", "debug 1", "info 2", "error" }));
+    EXPECT_EQ(attrs.level, priority::error);
+    EXPECT_EQ(detail::backlog<Captured>::size(), 0);
+}
+
+TEST_F(Backlog, Counted) {
+    constexpr auto messages_counter { static_cast<std::size_t>(detail::counter::messages) };
+    const auto before { detail::counters::snapshot() };
+    B::d("debug");
+    B::i("info");
+    B::e("error");
+    const auto after { detail::counters::snapshot() };
+    EXPECT_EQ(after[messages_counter] - before[messages_counter], 3);
+}
+
+TEST_F(Backlog, LastKept) {
+    for (int i = 0; i < 10; ++i) B::d("debug", i);
+    B::crit("critical");
+    EXPECT_EQ(messages, (std::vector<std::string> { "debug 6", "debug 7", "debug 8", "debug 9", "critical" }));
+}
+
+TEST_F(Backlog, PerThread) {
+    B::d("main");
+    std::thread { []() {
+        B::d("other");
+        B::e("failed");
+    } }.join();
+    EXPECT_EQ(messages, (std::vector<std::string> { "other", "failed" }));
+    EXPECT_EQ(detail::backlog<Captured>::size(), 1);
+}
+
+TEST_F(Backlog, Truncated) {
+    const std::string longer(300, 'x');
+    B::d("long", longer);
+    B::e("error");
+    EXPECT_EQ(messages.front().size(), detail::backlog<Captured>::record_size);
+}
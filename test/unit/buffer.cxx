@@ -61,9 +61,137 @@ TEST_F(Buffer, UsableAfterOverflow) {
     EXPECT_EQ(write_count, 2);
 }
 
+namespace {
+struct Counted {
+    static inline unsigned calls {};
+};
+}
+
+template<>
+struct logovod::formatter<Counted> {
+    template<typename Printer, typename Stream>
+    void operator()(Printer&, Stream& stream, const Counted&) {
+        ++Counted::calls;
+        stream << "element";
+    }
+};
+
+TEST_F(Buffer, StopsWhenFull) {
+    const std::vector<std::vector<Counted>> elements(4, std::vector<Counted>(4));
+    Counted::calls = 0;
+    L::i{}(elements, elements, "end");
+    EXPECT_EQ(message, "{{element,element,elemen");
+    EXPECT_EQ(Counted::calls, 3u);
+}
+
 TEST_F(Buffer, Unlimited) {
     std::string s(0x10000, '-');
     U::i{}(s); EXPECT_EQ(message, s);
     EXPECT_EQ(write_count, 1);
 }
 
+
+namespace {
+enum class Code : std::int16_t { ok = 0, failed = -42 };
+struct Grouping : std::numpunct<char> {
+    char do_thousands_sep() const override { return ','; }
+    std::string do_grouping() const override { return "\3"; }
+};
+}
+
+TEST_F(Buffer, Bounded) {
+    static_assert(L::max_size<int> == 13 + 1);
+    static_assert(L::max_size<decltype("took"), std::uint64_t, char> == 5 + 24 + 1 + 3);
+    static_assert(L::max_size<fixed<8, 2, double>> > 8);
+    static_assert(L::max_size<std::string_view> == detail::unbounded);
+    static_assert(L::max_size<int, decltype(std::setw(2))> == detail::unbounded);
+    static_assert(!L::may_truncate<short, bool>);
+    static_assert(L::may_truncate<decltype("a rather long literal text")>);
+    static_assert(L::may_truncate<std::string>);
+    static_assert(!U::may_truncate<decltype("a rather long literal text")>);
+
+    static constexpr auto c = consts::comma;
+    const signed char sc { -5 };
+    static_assert(!B::may_truncate<decltype("took"), int, decltype("ms"), char, bool, Code, signed char,
+        delimiter, unsigned, unsigned long long>);
+    B::i("took", -12345, "ms", 'x', true, Code::failed, sc, c, 1u, 2ull);
+    EXPECT_EQ(message, "took -12345 msx1 -42 -5,1,2");
+    const auto direct { message };
+    U::i("took", -12345, "ms", 'x', true, Code::failed, sc, c, 1u, 2ull);
+    EXPECT_EQ(message, direct);
+    L::i(std::numeric_limits<std::int64_t>::min());
+    EXPECT_EQ(message, "-9223372036854775808");
+    L::i(123456789, 123456789, 123456789);
+    EXPECT_EQ(message, "123456789 123456789 1234");
+    const auto global { std::locale::global(std::locale { std::locale::classic(), new Grouping }) };
+    L::i(1234567);
+    std::locale::global(global);
+    EXPECT_EQ(message, "1,234,567");
+}
+
+TEST_F(Buffer, Spilled) {
+    std::string s(100, '-');
+    S::i(s.substr(0, 10)); EXPECT_EQ(message, s.substr(0, 10));
+    S::i(s.substr(0, 40)); EXPECT_EQ(message, s.substr(0, 40));
+    S::i(1, s);            EXPECT_EQ(message, "1 " + s.substr(0, 62));
+    ST::i{}(s);              EXPECT_EQ(message, s.substr(0, 63) + '\n');
+    const auto capacity { detail::arena::local().capacity() };
+    EXPECT_GE(capacity, 64u);
+    ST::i{}(s);
+    S::i{} << s.substr(0, 20) << std::flush << s.substr(0, 30);
+    EXPECT_EQ(detail::arena::local().capacity(), capacity);
+    EXPECT_EQ(message, s.substr(0, 30));
+    static_assert(S::may_truncate<decltype("a rather long literal text, which does not fit into sixty four characters")>);
+    static_assert(!S::may_truncate<decltype("a literal that fits"), std::uint64_t>);
+    EXPECT_EQ(write_count, 7);
+}
+
+TEST_F(Chunks, Parts) {
+    std::string s(100, '-');
+    for (std::size_t i = 0; i < s.size(); i += 10) s[i] = static_cast<char>('0' + i / 10);
+    C::i{}("short");
+    ASSERT_EQ(records.size(), 1u);
+    EXPECT_EQ(records[0].message, "C:6:short\n");
+    EXPECT_EQ(records[0].attrs.part, 0u);
+    EXPECT_FALSE(records[0].attrs.continued);
+    records.clear();
+    C::i{}(s);
+    ASSERT_EQ(records.size(), 4u);
+    EXPECT_EQ(joined(), s);
+    for (std::size_t i = 0; i < records.size(); ++i) {
+        EXPECT_EQ(records[i].message, "C:6:" + records[i].payload + '\n');
+        EXPECT_LE(records[i].message.size(), 48u);
+        EXPECT_EQ(records[i].attrs.part, i);
+        EXPECT_EQ(records[i].attrs.continued, i + 1 != records.size());
+        EXPECT_EQ(records[i].attrs.sequence, records[0].attrs.sequence);
+    }
+    static_assert(!C::may_truncate<std::string>);
+}
+
+TEST_F(Chunks, Values) {
+    std::vector<int> v(16);
+    for (int i = 0; i < 16; ++i) v[static_cast<std::size_t>(i)] = i * 1000;
+    C::i{}("values", v, "end");
+    EXPECT_GT(records.size(), 2u);
+    EXPECT_EQ(joined(), "values {0,1000,2000,3000,4000,5000,6000,7000,8000,9000,10000,11000,12000,13000,14000,15000} end");
+    C::i i{};
+    i << std::string(40, '=') << std::flush;
+    EXPECT_FALSE(records.back().attrs.continued);
+    records.clear();
+    i << "reused" << std::flush;
+    ASSERT_EQ(records.size(), 1u);
+    EXPECT_EQ(records[0].message, "C:6:reused\n");
+    EXPECT_EQ(records[0].attrs.part, 0u);
+}
+
+TEST_F(Chunks, Joined) {
+    const std::string s(100, '-');
+    J::i{}(s);
+    EXPECT_EQ(message, "C:6:" + s + '\n');
+    EXPECT_EQ(payload, s);
+    EXPECT_EQ(attrs.part, 0u);
+    EXPECT_EQ(write_count, 1u);
+    J::i{}("short");
+    EXPECT_EQ(message, "C:6:short\n");
+    EXPECT_EQ(write_count, 2u);
+}
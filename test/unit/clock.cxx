@@ -0,0 +1,110 @@
+/*
+ * Copyright (C) 2024 Eugene Hutorny <eugene@hutorny.in.ua>
+ *
+ * This file is a part of logovod library
+ *
+ * Licensed under MIT License, see full text in LICENSE
+ * or visit page https://opensource.org/license/mit/
+ */
+
+#include "tests.h"
+#include <logovod/clock.h>
+#include <future>
+#include <memory>
+#include <thread>
+
+using namespace logovod::tests;
+using namespace logovod;
+
+namespace {
+template<class Source>
+std::chrono::milliseconds skew() {
+    using namespace std::chrono;
+    const auto stamp { Source::now() };
+    return duration_cast<milliseconds>(abs(stamp.to_sys() - system_clock::now()));
+}
+
+// System clock stepping back an hour on each reading
+struct SteppingBack {
+    static std::chrono::system_clock::time_point now() noexcept {
+        static auto time { std::chrono::system_clock::now() };
+        return time -= std::chrono::hours { 1 };
+    }
+};
+
+struct TscTraits : sink::prolog::prolog_traits {
+    using clock = logovod::clock::tsc;
+};
+}
+
+TEST(Clock, Sources) {
+    using namespace std::chrono_literals;
+    EXPECT_LE(skew<clock::system>(), 1ms);
+    EXPECT_LE(skew<clock::coarse>(), 20ms);
+    EXPECT_LE(skew<clock::tsc>(), 5ms);
+}
+
+TEST(Clock, Deferred) {
+    using namespace std::chrono;
+    const auto stamp { clock::tsc::now() };
+    std::this_thread::sleep_for(milliseconds { 20 });
+    const auto age { system_clock::now() - stamp.to_sys() };
+    EXPECT_GE(age, milliseconds { 15 });
+    EXPECT_LE(age, milliseconds { 200 });
+    EXPECT_EQ(clock::timestamp {}.to_sys(), clock::sys_time {});
+}
+
+TEST(Clock, SteppedBack) {
+    using namespace std::chrono;
+    using tsc = clock::basic_tsc<SteppingBack>;
+    // the thread is detached, it outlives the test if the conversion hangs
+    const auto converted { std::make_shared<std::promise<clock::sys_time>>() };
+    auto result { converted->get_future() };
+    std::thread { [converted]() {
+        const auto stamp { tsc::now() };
+        SteppingBack::now();
+        converted->set_value(stamp.to_sys());
+    } }.detach();
+    ASSERT_EQ(result.wait_for(seconds { 1 }), std::future_status::ready);
+    const auto first { result.get() };
+    std::this_thread::sleep_for(milliseconds { 20 });
+    SteppingBack::now();
+    const auto age { tsc::now().to_sys() - first };
+    EXPECT_GE(age, milliseconds { 15 });
+    EXPECT_LE(age, milliseconds { 200 });
+}
+
+TEST_F(LoggerTest, ClockProlog) {
+    std::ostringstream out;
+    sink::prolog::common<TscTraits>(out, { priority::informational, "clock", {}, {} });
+    EXPECT_NE(out.str().find("|clock   |INFO     |"), std::string::npos);
+    L::i(clock::timestamp { 0, clock::system::to_sys });
+    EXPECT_EQ(message.substr(message.size() - 10), ".000000000");
+}
+
+TEST(Clock, Rendered) {
+    using namespace std::chrono;
+    using detail::time_renderer;
+    char text[time_renderer::max_size];
+    const auto render = [&text](system_clock::time_point tp, time_precision precision) {
+        return std::string { text, time_renderer::render(text, tp, precision, true) };
+    };
+    const system_clock::time_point tp { duration_cast<system_clock::duration>(nanoseconds { 1709880066977543219 }) };
+    EXPECT_EQ(render(tp, time_precision::seconds), "2024-03-08T06:41:06");
+    EXPECT_EQ(render(tp, time_precision::milliseconds), "2024-03-08T06:41:06.977");
+    EXPECT_EQ(render(tp, time_precision::microseconds), "2024-03-08T06:41:06.977543");
+    EXPECT_EQ(render(tp, time_precision::nanoseconds), "2024-03-08T06:41:06.977543219");
+    EXPECT_EQ(render(system_clock::time_point { 951782400s }, time_precision::seconds), "2000-02-29T00:00:00");
+    EXPECT_EQ(render(system_clock::time_point { -1s }, time_precision::milliseconds), "1969-12-31T23:59:59.000");
+    setenv("TZ", "UTC", true);
+    char local[time_renderer::max_size];
+    const auto size { time_renderer::render(local, tp, time_precision::milliseconds, false) };
+    EXPECT_EQ(std::string_view(local, size), "2024-03-08T06:41:06.977");
+    setenv("TZ", "EST5EDT,M3.2.0,M11.1.0", true);
+    // changes of TZ are followed when the quarter hour of the rendered time changes
+    time_renderer::render(local, tp + 1h, time_precision::seconds, false);
+    EXPECT_EQ(std::string_view(local, 19), "2024-03-08T02:41:06");
+    time_renderer::render(local, tp + 24h * 7, time_precision::seconds, false);
+    EXPECT_EQ(std::string_view(local, 19), "2024-03-15T02:41:06");
+    unsetenv("TZ");
+}
@@ -0,0 +1,172 @@
+/*
+ * Copyright (C) 2024 Eugene Hutorny <eugene@hutorny.in.ua>
+ *
+ * This file is a part of logovod library
+ *
+ * Licensed under MIT License, see full text in LICENSE
+ * or visit page https://opensource.org/license/mit/
+ */
+
+#include "tests.h"
+#include <cstdlib>
+#include <fstream>
+#include <thread>
+#if __has_include(<sys/inotify.h>)
+#include <logovod/watcher.h>
+#endif
+
+using namespace logovod::tests;
+using namespace logovod;
+
+TEST_F(Config, Registered) {
+    unsigned found {};
+    detail::registry::for_each([&found](const detail::category_entry& entry) {
+        if (entry.tag == Http::tag || entry.tag == Tcp::tag || entry.tag == Db::tag || entry.tag == Cache::tag) {
+            found++;
+        }
+    });
+    EXPECT_EQ(found, 4);
+    R::category_type::level();
+}
+
+TEST_F(Config, LevelParsed) {
+    EXPECT_EQ(config::parse_level("warning").level, priority::warning);
+    EXPECT_EQ(config::parse_level("warn").level, priority::warning);
+    EXPECT_EQ(config::parse_level("w").level, priority::warning);
+    EXPECT_EQ(config::parse_level("4").level, priority::warning);
+    EXPECT_EQ(config::parse_level("info").level, priority::informational);
+    EXPECT_EQ(config::parse_level("emerg").level, priority::emergency);
+    EXPECT_EQ(config::parse_level("default").kind, config::level_value::fallback);
+    EXPECT_EQ(config::parse_level("8").kind, config::level_value::invalid);
+    EXPECT_EQ(config::parse_level("verbose").kind, config::level_value::invalid);
+}
+
+TEST_F(Config, WildcardApplied) {
+    EXPECT_TRUE(config::apply("net.*=warning"));
+    EXPECT_EQ(Http::level(), priority::warning);
+    EXPECT_EQ(Tcp::level(), priority::warning);
+    EXPECT_EQ(Db::level(), priority::debug);
+    H::i("ignored");                            EXPECT_EQ(message, "");
+    H::w("written");                            EXPECT_EQ(message, "written");
+}
+
+TEST_F(Config, LastRulePrevails) {
+    EXPECT_TRUE(config::apply("net.*=error,net.tcp=notice db*=crit"));
+    EXPECT_EQ(Http::level(), priority::error);
+    EXPECT_EQ(Tcp::level(), priority::notice);
+    EXPECT_EQ(Db::level(), priority::critical);
+    EXPECT_EQ(Cache::level(), priority::critical);
+    EXPECT_TRUE(config::apply("db.cache=default"));
+    EXPECT_EQ(Cache::level(), priority::error);
+}
+
+TEST_F(Config, MalformedRejected) {
+    EXPECT_FALSE(config::apply("net.*=warning,db=loud"));
+    EXPECT_FALSE(config::apply("net.*"));
+    EXPECT_FALSE(config::apply("=debug"));
+    EXPECT_EQ(Http::level(), priority::debug);
+    EXPECT_EQ(Db::level(), priority::debug);
+}
+
+TEST_F(Config, EnvironmentLoaded) {
+    ::setenv("LOGOVOD_TEST", "net.http=alert", 1);
+    EXPECT_TRUE(config::load_env("LOGOVOD_TEST"));
+    EXPECT_EQ(Http::level(), priority::alert);
+    EXPECT_EQ(Tcp::level(), priority::debug);
+    ::unsetenv("LOGOVOD_TEST");
+}
+
+TEST_F(Config, FileLoaded) {
+    const auto path { std::filesystem::temp_directory_path() / "logovod-config-test.conf" };
+    std::ofstream{ path } << "# test configuration\nnet.tcp=err # inline comment\n\ndb=i\n";
+    EXPECT_TRUE(config::load(path));
+    EXPECT_EQ(Tcp::level(), priority::error);
+    EXPECT_EQ(Db::level(), priority::informational);
+    std::filesystem::remove(path);
+    EXPECT_FALSE(config::load(path));
+}
+
+TEST_F(Config, SinkRouted) {
+    config::add_sink("local", { nullptr, [](std::string_view msg, std::string_view, attributes) noexcept { local = msg; }, nullptr });
+    EXPECT_FALSE(config::apply("routed=>remote"));
+    EXPECT_TRUE(config::apply("routed=warning>local"));
+    R::w("routed");                             EXPECT_EQ(local, "routed"); EXPECT_EQ(message, "");
+    EXPECT_EQ(config::sink_name(Routed::writer()), "local");
+    EXPECT_TRUE(config::apply("net.*=debug"));
+    R::e("restored");                           EXPECT_EQ(message, "restored");
+    R::w("ignored");                            EXPECT_EQ(message, "restored");
+    EXPECT_EQ(Routed::level(), priority::error);
+}
+
+TEST_F(Config, FilterApplied) {
+    const auto site { source_location::current() };
+    const auto range { "line=" + std::to_string(site.line()) + "-" + std::to_string(site.line() + 1) };
+    EXPECT_TRUE(config::filter("tag=net.* file=*config.cxx " + range + " level=debug; tag=net.* level=warning\n"
+        "tag=db level=none # db is muted"));
+    EXPECT_EQ(detail::filters::size(), 3);
+    H::d(site, "site passed");                  EXPECT_EQ(message, "site passed");
+    H::i("other rejected");                     EXPECT_EQ(message, "site passed");
+    T::w("other passed");                       EXPECT_EQ(message, "other passed");
+    D::emerg("muted");                          EXPECT_EQ(message, "other passed");
+    C::error("unfiltered");                     EXPECT_EQ(message, "unfiltered");
+    EXPECT_TRUE(config::filter("tag=db level=error"));
+    D::error("changed");                        EXPECT_EQ(message, "changed");
+    H::i("unfiltered");                         EXPECT_EQ(message, "unfiltered");
+    EXPECT_TRUE(config::filter(""));
+    EXPECT_FALSE(detail::filters::active());
+}
+
+TEST_F(Config, FilterMalformed) {
+    EXPECT_TRUE(config::filter("tag=db level=error"));
+    EXPECT_FALSE(config::filter("tag=db"));
+    EXPECT_FALSE(config::filter("tag=db level=verbose"));
+    EXPECT_FALSE(config::filter("tag=db line=20-10 level=info"));
+    EXPECT_FALSE(config::filter("host=db level=info"));
+    EXPECT_EQ(detail::filters::size(), 1);
+}
+
+TEST_F(Config, SiteEnabled) {
+    const auto site { source_location::current() };
+    const auto other { source_location::current() };
+    const std::string rule { "@config.cxx:" + std::to_string(site.line()) + "=debug" };
+    EXPECT_TRUE(config::apply(rule + ",db=error"));
+    D::d(site, "site enabled");                 EXPECT_EQ(message, "site enabled");
+    D::d(other, "other ignored");               EXPECT_EQ(message, "site enabled");
+    D::log(priority::informational, site, "site logged"); EXPECT_EQ(message, "site logged");
+    C::d(site, "not overridable");              EXPECT_EQ(message, "site logged");
+    EXPECT_FALSE(config::apply("@config.cxx=debug"));
+    EXPECT_FALSE(config::apply("@config.cxx:0=debug"));
+    EXPECT_FALSE(config::apply("@config.cxx:12=default"));
+    EXPECT_TRUE(config::apply("db=error"));
+    D::d(site, "site disabled");                EXPECT_EQ(message, "site logged");
+}
+
+#if __has_include(<sys/inotify.h>)
+TEST_F(Config, FileWatched) {
+    using namespace std::chrono_literals;
+    const auto dir { std::filesystem::temp_directory_path() / "logovod-watcher-test" };
+    std::filesystem::create_directories(dir);
+    const auto path { dir / "log.conf" };
+    std::ofstream{ path } << "net.http=warning\n";
+    config::watcher watcher { path };
+    ASSERT_TRUE(watcher.active());
+    EXPECT_EQ(watcher.reloads(), 1);
+    EXPECT_EQ(Http::level(), priority::warning);
+    const auto wait = [&watcher](unsigned count) {
+        for (int i = 0; i < 500 && watcher.reloads() + watcher.failures() < count; ++i) std::this_thread::sleep_for(2ms);
+    };
+    std::ofstream{ path } << "net.http=critical\n";
+    wait(2);
+    EXPECT_EQ(Http::level(), priority::critical);
+    const auto temp { dir / "log.conf.tmp" };
+    std::ofstream{ temp } << "net.http=notice\n";
+    std::filesystem::rename(temp, path);
+    wait(3);
+    EXPECT_EQ(Http::level(), priority::notice);
+    std::ofstream{ path } << "net.http=loud\n";
+    wait(4);
+    EXPECT_EQ(watcher.failures(), 1);
+    EXPECT_EQ(Http::level(), priority::notice);
+    std::filesystem::remove_all(dir);
+}
+#endif
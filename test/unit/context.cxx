@@ -0,0 +1,73 @@
+/*
+ * Copyright (C) 2024 Eugene Hutorny <eugene@hutorny.in.ua>
+ *
+ * This file is a part of logovod library
+ *
+ * Licensed under MIT License, see full text in LICENSE
+ * or visit page https://opensource.org/license/mit/
+ */
+
+#include "tests.h"
+#include <thread>
+
+using namespace logovod::tests;
+using namespace logovod;
+
+TEST_F(Context, Scoped) {
+    L::i("none");               EXPECT_TRUE(attrs.context.empty());
+    {
+        context_scope request { "request", "r42" };
+        L::i("one");            EXPECT_EQ(attrs.context.text(), "request=r42");
+        {
+            context_scope user { "user", std::string { "alice" } };
+            L::i("two");        EXPECT_EQ(attrs.context.text(), "request=r42 user=alice");
+                                EXPECT_EQ(attrs.context.size(), 2);
+                                EXPECT_EQ(attrs.context.find("user"), "alice");
+                                EXPECT_EQ(attrs.context.find("request"), "r42");
+        }
+        L::i("one");            EXPECT_EQ(attrs.context.text(), "request=r42");
+                                EXPECT_EQ(attrs.context.find("user"), "");
+    }
+    L::i("none");               EXPECT_TRUE(attrs.context.empty());
+}
+
+TEST_F(Context, Values) {
+    context_scope a { "id", 42 };
+    context_scope b { "ratio", 0.5 };
+    context_scope c { "ok", true };
+    context_scope d { "c", 'x' };
+    L::i("values");
+    std::string pairs;
+    attrs.context.for_each([&pairs](std::string_view key, std::string_view value) {
+        pairs.append(key).append(":").append(value).append(";");
+    });
+    EXPECT_EQ(pairs, "id:42;ratio:0.5;ok:true;c:120;");
+}
+
+TEST_F(Context, Full) {
+    const std::string large(detail::context::text_size, 'x');
+    context_scope a { "a", 1 };
+    context_scope dropped { "large", large };
+    context_scope b { "b", 2 };
+    L::i("full");               EXPECT_EQ(attrs.context.text(), "a=1 b=2");
+}
+
+TEST_F(Context, Captured) {
+    context_scope request { "request", "r7" };
+    const auto captured { context_scope::capture() };
+    std::string seen;
+    std::thread { [&captured, &seen]() {
+        context_scope restored { captured };
+        context_scope step { "step", 2 };
+        L::i("async");
+        seen = attrs.context.text();
+    } }.join();
+    EXPECT_EQ(seen, "request=r7 step=2");
+}
+
+TEST_F(Context, Prolog) {
+    context_scope request { "request", "r9" };
+    S::i("message");
+    EXPECT_NE(message.find("|request=r9|message"), message.npos);
+    EXPECT_EQ(payload, "message");
+}
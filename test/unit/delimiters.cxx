@@ -36,3 +36,19 @@ TEST_F(Delimiters, Override) {
     C::i(separators{'<','/','>'}, s);   EXPECT_EQ(message,"<a/B/c>");
 }
 
+
+TEST_F(Delimiters, Literals) {
+    using namespace std;
+    static constexpr auto n = consts::none;
+    const string_view host { "host" };
+    char buffer[16] { "buffer" };
+    L::i("a", "b", "c");                    EXPECT_EQ(message,"a b c");
+    L::i("to", host, "port", 80, "ms");     EXPECT_EQ(message,"to host port 80 ms");
+    C::i("a", "b", 1, "c");                 EXPECT_EQ(message,"a_b_1_c");
+    L::i("a", n, "b", "c", 1);              EXPECT_EQ(message,"abc1");
+    L::i("x", '=', "y", ';');               EXPECT_EQ(message,"x=y;");
+    L::i("ab\0cd", "e");                    EXPECT_EQ(message,"ab e");
+    L::i(buffer, "end");                    EXPECT_EQ(message,"buffer end");
+    L::i("[", setw(4), "a", "]");           EXPECT_EQ(message,"[   a ]");
+    L::i(1, "a", setw(3), "b", "c");        EXPECT_EQ(message,"1 a  b c");
+}
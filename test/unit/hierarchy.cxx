@@ -8,6 +8,8 @@
  */
 
 #include "tests.h"
+#include <thread>
+
 using namespace logovod;
 using namespace logovod::tests;
 
@@ -159,4 +161,13 @@ TEST_F(Optional, SinksOverriden) {
     D::e("D error");                            EXPECT_EQ(local,"P:D error:e"); EXPECT_EQ(message,"");   reset();
 }
 
-
+TEST_F(Optional, ChangesSeenByOtherThreads) {
+    D::e("D error");                            EXPECT_EQ(message,"D error");   reset();
+    A::category_type::level(priority::critical);
+    std::thread{[]() { D::e("D ignored"); }}.join();
+    EXPECT_EQ(message,"");
+    std::thread{[]() { D::c("D critical"); }}.join();
+    EXPECT_EQ(message,"D critical");            reset();
+    A::category_type::nolevel();
+    D::e("D error");                            EXPECT_EQ(message,"D error");   reset();
+}
@@ -14,6 +14,7 @@
 #include <list>
 #include <forward_list>
 #include <optional>
+#include <thread>
 #include <variant>
  
 using namespace logovod::tests;
@@ -98,3 +99,45 @@ TEST_F(Levels, RuntimeRespectedEmergency) {
     R::emergency("emergency"); EXPECT_EQ(message, "emergency");
     EXPECT_EQ(write_count, 1);
 }
+
+TEST_F(Levels, ThreadElevated) {
+    {
+        level_scope scope { priority::debug };
+        L::d("static");         EXPECT_EQ(message, "static");
+        R::w("runtime");        EXPECT_EQ(message, "runtime");
+        std::thread { []() {
+            R::w("other thread");
+        } }.join();
+        EXPECT_EQ(message, "runtime");
+        {
+            level_scope inner { priority::notice };
+            L::i("ignored");    EXPECT_EQ(message, "runtime");
+            L::n("notice");     EXPECT_EQ(message, "notice");
+        }
+        L::i("restored");       EXPECT_EQ(message, "restored");
+    }
+    L::d("ignored");            EXPECT_EQ(message, "restored");
+    EXPECT_EQ(write_count, 4);
+}
+
+TEST_F(Levels, ElevationOptedIn) {
+    level_scope scope { priority::debug };
+    F::d("ignored");            EXPECT_EQ(message, "");
+    F::w("warning");            EXPECT_EQ(message, "warning");
+    EXPECT_EQ(write_count, 1);
+}
+
+TEST_F(Levels, ElevationCarried) {
+    level_scope::snapshot captured;
+    {
+        level_scope scope { priority::informational };
+        captured = level_scope::capture();
+    }
+    std::thread { [captured]() {
+        level_scope scope { captured };
+        R::i("carried");
+        R::d("ignored");
+    } }.join();
+    EXPECT_EQ(message, "carried");
+    R::i("ignored");            EXPECT_EQ(message, "carried");
+}
@@ -0,0 +1,51 @@
+/*
+ * Copyright (C) 2024 Eugene Hutorny <eugene@hutorny.in.ua>
+ *
+ * This file is a part of logovod library
+ *
+ * Licensed under MIT License, see full text in LICENSE
+ * or visit page https://opensource.org/license/mit/
+ */
+
+#include "tests.h"
+
+using namespace logovod::tests;
+using namespace logovod;
+
+TEST_F(Limits, FirstAdmitted) {
+    for (int i = 0; i < 5; ++i) logger<First>::w{}("first", i);
+    EXPECT_EQ(write_count, 2);                  EXPECT_EQ(message, "first 1");
+    for (int i = 0; i < 5; ++i) logger<First>::w{}("other", i);
+    EXPECT_EQ(write_count, 4);                  EXPECT_EQ(message, "other 1");
+}
+
+TEST_F(Limits, EveryNthAdmitted) {
+    const auto before { detail::counters::snapshot() };
+    for (int i = 0; i < 10; ++i) logger<Every>::w{}("every", i);
+    EXPECT_EQ(write_count, 4);                  EXPECT_EQ(message, "every 9 [2 suppressed]");
+    EXPECT_EQ(payload, "every 9");
+    const auto after { detail::counters::snapshot() };
+    constexpr auto suppressed { static_cast<std::size_t>(detail::counter::suppressed) };
+    EXPECT_EQ(after[suppressed] - before[suppressed], 6);
+}
+
+TEST_F(Limits, BucketDrained) {
+    for (int i = 0; i < 10; ++i) logger<Bucket>::w{}("bucket", i);
+    EXPECT_EQ(write_count, 3);                  EXPECT_EQ(message, "bucket 2");
+}
+
+TEST_F(Limits, Sampled) {
+    for (int i = 0; i < 1000; ++i) logger<Sample>::w{}("sample", i);
+    EXPECT_GT(write_count, 150);
+    EXPECT_LT(write_count, 350);
+}
+
+TEST_F(Limits, StreamSuppressed) {
+    for (int i = 0; i < 3; ++i) {
+        logger<First>::w log {};
+        log << "stream" << i << std::endl;
+        log << "again" << i << std::endl;
+    }
+    // a reused emitter has no location, its messages are limited as those without location
+    EXPECT_EQ(write_count, 4);                  EXPECT_EQ(message, "again1");
+}
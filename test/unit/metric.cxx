@@ -0,0 +1,63 @@
+/*
+ * Copyright (C) 2024 Eugene Hutorny <eugene@hutorny.in.ua>
+ *
+ * This file is a part of logovod library
+ *
+ * Licensed under MIT License, see full text in LICENSE
+ * or visit page https://opensource.org/license/mit/
+ */
+
+#include "tests.h"
+#include <thread>
+
+using namespace logovod::tests;
+using namespace logovod;
+
+TEST_F(Metrics, BucketsBounded) {
+    using metrics::histogram;
+    for (std::uint64_t v : { 0ull, 1ull, 31ull, 32ull, 63ull, 64ull, 1000ull, 123456789ull, ~0ull }) {
+        const auto b { histogram::bucket(v) };
+        ASSERT_LT(b, histogram::size);
+        const auto mid { histogram::value(b) };
+        EXPECT_LE(mid > v ? mid - v : v - mid, v / 32) << v;
+    }
+    EXPECT_EQ(histogram::value(histogram::bucket(63)), 63);
+    EXPECT_LT(histogram::bucket(1000), histogram::bucket(1100));
+}
+
+TEST_F(Metrics, HistogramReported) {
+    // a single call site, recorded by two threads
+    const auto record { [](int i) { M::metric("latency", i); } };
+    std::thread { [&record]() {
+        for (int i = 1; i <= 500; ++i) record(i);
+    } }.join();
+    for (int i = 501; i <= 1000; ++i) record(i);
+    aggregate::report();
+    EXPECT_EQ(write_count, 1);
+    EXPECT_EQ(attrs.tag, "measured");
+    EXPECT_EQ(payload.substr(0, 18), "metric latency at ");
+    const auto stats { payload.substr(payload.find(" count ")) };
+    EXPECT_EQ(stats.substr(0, 31), " count 1000 min 1 max 1000 p50 ");
+    const auto p50 { std::stoi(stats.substr(31)) };
+    EXPECT_NEAR(p50, 500, 16);
+    const auto p99 { std::stoi(stats.substr(stats.find("p99 ") + 4)) };
+    EXPECT_NEAR(p99, 990, 32);
+    aggregate::report();
+    EXPECT_EQ(write_count, 1);
+}
+
+TEST_F(Metrics, CounterReported) {
+    for (int i = 0; i < 5; ++i) M::count("retries");
+    M::count("retries", 10, source_location::current());
+    aggregate::report();
+    EXPECT_EQ(write_count, 2);
+    EXPECT_EQ(payload.substr(0, 19), "counter retries at ");
+    EXPECT_EQ(payload.substr(payload.rfind(' ')), " 10");
+}
+
+TEST_F(Metrics, DisabledIgnored) {
+    Q::metric("ignored", 1);
+    Q::count("ignored");
+    aggregate::report();
+    EXPECT_EQ(write_count, 0);
+}
@@ -0,0 +1,50 @@
+/*
+ * Copyright (C) 2024 Eugene Hutorny <eugene@hutorny.in.ua>
+ *
+ * This file is a part of logovod library
+ *
+ * Licensed under MIT License, see full text in LICENSE
+ * or visit page https://opensource.org/license/mit/
+ */
+
+#include "tests.h"
+
+using namespace logovod::tests;
+using namespace logovod;
+using namespace std::chrono_literals;
+
+TEST_F(Shedding, LatencyShed) {
+    B::d("before");                             EXPECT_EQ(message, "before");
+    for (int i = 0; i < 4; ++i) shedding::governor::latency(10ms);
+    EXPECT_TRUE(shedding::governor::snapshot().shedding);
+    EXPECT_EQ(Busy::level(), priority::warning);
+    EXPECT_EQ(Child::level(), priority::warning);
+    EXPECT_EQ(event, "load shedding started, level capped at warning latency 1250000 ns depth 0\n");
+    B::i("shed");                               EXPECT_EQ(message, "before");
+    C::d("shed");                               EXPECT_EQ(message, "before");
+    B::w("kept");                               EXPECT_EQ(message, "kept");
+    for (int i = 0; i < 16; ++i) shedding::governor::latency(500us);
+    EXPECT_TRUE(shedding::governor::snapshot().shedding);
+    for (int i = 0; i < 32; ++i) shedding::governor::latency(10us);
+    EXPECT_FALSE(shedding::governor::snapshot().shedding);
+    EXPECT_EQ(shedding::governor::snapshot().transitions, 2);
+    EXPECT_EQ(event.substr(0, 48), "load shedding stopped, level restored to debug l");
+    B::d("restored");                           EXPECT_EQ(message, "restored");
+}
+
+TEST_F(Shedding, DepthShed) {
+    Busy::level(priority::informational);
+    shedding::governor::depth(5000);
+    EXPECT_EQ(Busy::level(), priority::warning);
+    shedding::governor::depth(500);
+    EXPECT_EQ(Busy::level(), priority::warning);
+    shedding::governor::depth(50);
+    EXPECT_EQ(Busy::level(), priority::informational);
+    Busy::level(priority::debug);
+}
+
+TEST_F(Shedding, WritesMetered) {
+    sink::metered<LoggerTest::testsink>("metered", "metered", {});
+    EXPECT_EQ(message, "metered");
+    EXPECT_FALSE(shedding::governor::snapshot().shedding);
+}
@@ -8,6 +8,9 @@
  */
 
 #include "tests.h"
+#include <atomic>
+#include <thread>
+#include <vector>
 
 using namespace logovod::tests;
 using namespace logovod;
@@ -124,3 +127,98 @@ TEST_F(Sinks, Payload) {
     EXPECT_EQ(local_message2, "Test2");
     EXPECT_EQ(write_count, 0);
 }
+
+TEST_F(Sinks, RuntimeSwapSynchronized) {
+    static std::atomic<unsigned> retired_calls {};
+    static std::atomic<unsigned> current_calls {};
+    std::atomic<bool> stop {};
+    L::category_type::writer([](std::string_view, std::string_view, attributes) noexcept {
+        retired_calls.fetch_add(1, std::memory_order_relaxed);
+    });
+    std::vector<std::thread> threads {};
+    for (int n = 0; n < 4; ++n) {
+        threads.emplace_back([&stop]() {
+            while (!stop.load(std::memory_order_relaxed)) L::i("Concurrent");
+        });
+    }
+    while (retired_calls.load() < 1000) std::this_thread::yield();
+    L::category_type::writer([](std::string_view, std::string_view, attributes) noexcept {
+        current_calls.fetch_add(1, std::memory_order_relaxed);
+    });
+    L::category_type::synchronize();
+    const auto retired { retired_calls.load() };
+    while (current_calls.load() < 1000) std::this_thread::yield();
+    stop = true;
+    for (auto& t : threads) t.join();
+    EXPECT_EQ(retired_calls.load(), retired);
+    EXPECT_EQ(write_count, 0);
+}
+
+TEST_F(Sinks, DuplicatesCounted) {
+    for (int i = 0; i < 5; ++i) D::e("storm");
+    EXPECT_EQ(write_count, 1);                  EXPECT_EQ(message, "storm\n");
+    O::e("storm");
+    EXPECT_EQ(write_count, 2);                  EXPECT_EQ(attrs.tag, "O");
+    D::e("calm");
+    EXPECT_EQ(write_count, 4);                  EXPECT_EQ(message, "calm\n");
+    D::e("calm");
+    D::e("storm");
+    EXPECT_EQ(write_count, 6);                  EXPECT_EQ(message, "storm\n");
+}
+
+TEST_F(Sinks, DuplicatesSummarized) {
+    D::e("burst");
+    D::e("burst");
+    D::e("burst");
+    D::e("other");
+    EXPECT_EQ(write_count, 3);
+    std::vector<std::string> messages;
+    std::thread { [&messages]() {
+        D::w("thread");
+        D::w("thread");
+        messages.push_back(message);
+    } }.join();
+    EXPECT_EQ(messages.front(), "thread\n");
+    EXPECT_EQ(message, "last message repeated 1 times\n");
+    EXPECT_EQ(payload, "last message repeated 1 times");
+    EXPECT_EQ(attrs.level, priority::warning);
+}
+
+TEST_F(Sinks, DuplicatesExpired) {
+    D::e("stopped");
+    D::e("stopped");
+    std::this_thread::sleep_for(std::chrono::milliseconds { 60 });
+    // a write of another category summarizes the expired burst
+    O::e("other");
+    EXPECT_EQ(write_count, 3);                  EXPECT_EQ(message, "other\n");
+    D::e("reported");
+    D::e("reported");
+    {
+        // the burst stops, the summary is written by the reporter after the timeout
+        aggregate::reporter reporter { std::chrono::milliseconds { 10 } };
+        std::this_thread::sleep_for(std::chrono::milliseconds { 100 });
+    }
+    EXPECT_EQ(write_count, 5);                  EXPECT_EQ(message, "last message repeated 1 times\n");
+    aggregate::report();
+    EXPECT_EQ(write_count, 5);
+}
+
+TEST_F(Sinks, DuplicatesPrologued) {
+    P::e("prologued");
+    P::w("prologued");
+    EXPECT_EQ(write_count, 1);                  EXPECT_EQ(message, "P:3:prologued\n");
+    std::this_thread::sleep_for(std::chrono::milliseconds { 60 });
+    P::n("prologued");
+    // the summary has the prolog of the last suppressed message
+    EXPECT_EQ(write_count, 2);                  EXPECT_EQ(message, "P:5:last message repeated 2 times\n");
+    EXPECT_EQ(payload, "last message repeated 2 times");
+    EXPECT_EQ(attrs.level, priority::notice);
+}
+
+TEST_F(Sinks, DuplicatesTimedOut) {
+    D::e("timed");
+    D::e("timed");
+    std::this_thread::sleep_for(std::chrono::milliseconds { 60 });
+    D::e("timed");
+    EXPECT_EQ(write_count, 2);                  EXPECT_EQ(message, "last message repeated 2 times\n");
+}
@@ -0,0 +1,73 @@
+/*
+ * Copyright (C) 2024 Eugene Hutorny <eugene@hutorny.in.ua>
+ *
+ * This file is a part of logovod library
+ *
+ * Licensed under MIT License, see full text in LICENSE
+ * or visit page https://opensource.org/license/mit/
+ */
+
+#include "tests.h"
+#include <fstream>
+#include <sstream>
+
+using namespace logovod::tests;
+using namespace logovod;
+
+TEST_F(Spans, Logged) {
+    {
+        span<TestCategory> timing { "work" };
+        EXPECT_NE(timing.id(), 0);
+    }
+    EXPECT_EQ(write_count, 1);
+    EXPECT_EQ(payload.rfind("work ", 0), 0);
+    EXPECT_EQ(payload.substr(payload.size() - 2), "ns");
+    EXPECT_EQ(attrs.level, priority::debug);
+}
+
+TEST_F(Spans, Disabled) {
+    {
+        span<Quiet> timing { "quiet" };
+        EXPECT_EQ(timing.id(), 0);
+    }
+    EXPECT_EQ(write_count, 0);
+}
+
+TEST_F(Spans, Nested) {
+    trace::writer(collect);
+    {
+        span<Quiet> outer { "outer" };
+        {
+            span<Quiet, priority::warning> inner { "inner" };
+            EXPECT_NE(inner.id(), outer.id());
+        }
+        EXPECT_EQ(write_count, 1);
+    }
+    ASSERT_EQ(events.size(), 2);
+    EXPECT_EQ(events[0].name, "inner");
+    EXPECT_EQ(events[1].name, "outer");
+    EXPECT_EQ(events[0].parent, events[1].id);
+    EXPECT_EQ(events[1].parent, 0);
+    EXPECT_EQ(events[0].thread, events[1].thread);
+    EXPECT_GE(events[1].duration, events[0].duration);
+}
+
+TEST_F(Spans, Chrome) {
+    const auto path { std::filesystem::temp_directory_path() / "logovod-spans.json" };
+    sink::chrome<0>::open(path);
+    {
+        span<Quiet> outer { "outer \"quoted\"" };
+        span<Quiet> inner { "inner" };
+    }
+    sink::chrome<0>::close();
+    std::stringstream text;
+    text << std::ifstream { path }.rdbuf();
+    const auto json { text.str() };
+    EXPECT_EQ(json.front(), '[');
+    EXPECT_EQ(json.substr(json.size() - 2), "]\n");
+    EXPECT_NE(json.find(R"("name":"outer \"quoted\"")"), json.npos);
+    EXPECT_NE(json.find(R"("name":"inner","cat":"")"), json.npos);
+    EXPECT_NE(json.find(R"("ph":"X")"), json.npos);
+    EXPECT_NE(json.find("},\n{"), json.npos);
+    std::filesystem::remove(path);
+}
@@ -260,6 +260,24 @@ TEST_F(Containers, RangeLimit) {
     EXPECT_EQ(write_count, 2);
 }
 
+TEST_F(Containers, ElementLimit) {
+    std::vector<std::vector<int>> vv { {1,2}, {3,4}, {5,6} };
+    E::i{}(vv, vv);  EXPECT_EQ(message, "{{1,2},{3,...},...} {...}");
+    E::i{}(vv[0]);   EXPECT_EQ(message, "{1,2}");
+    EXPECT_EQ(write_count, 2);
+}
+
+TEST_F(Containers, ByteLimit) {
+    std::vector<int> v20(20, 1);
+    const auto before { detail::counters::snapshot() };
+    B::i{}("values", v20, "end"); EXPECT_EQ(message, "values {1,1,...}");
+    B::i{}("short", 1);           EXPECT_EQ(message, "short 1");
+    const auto after { detail::counters::snapshot() };
+    const auto truncated { static_cast<std::size_t>(detail::counter::truncated) };
+    EXPECT_EQ(after[truncated] - before[truncated], 1u);
+    EXPECT_EQ(write_count, 2);
+}
+
 TEST_F(Structures, Tuple) {
     std::tuple<int, const char*> icc { 10, "char*" };
     const std::tuple<char, std::string> cs { 'A', "Str" };
@@ -322,13 +340,17 @@ TEST_F(Structures, Timepoint) {
         L::i{}(tpm);      EXPECT_EQ(message, "2024-03-08 06:41:06.977000000");
         L::i{} << tps;    EXPECT_EQ(message, "2024-03-08 06:41:06.000000000");
     } else {
-        L::i{}(tpu);      EXPECT_EQ(message, "2024-03-08T06:41:06.977");
-        L::i{}(tps);      EXPECT_EQ(message, "2024-03-08T06:41:06.000");
-        L::i{}(tpm);      EXPECT_EQ(message, "2024-03-08T06:41:06.977");
-        L::i{} << tps;    EXPECT_EQ(message, "2024-03-08T06:41:06.000");
+        L::i{}(tpu);      EXPECT_EQ(message, "2024-03-08T06:41:06.977543000");
+        L::i{}(tps);      EXPECT_EQ(message, "2024-03-08T06:41:06.000000000");
+        L::i{}(tpm);      EXPECT_EQ(message, "2024-03-08T06:41:06.977000000");
+        L::i{} << tps;    EXPECT_EQ(message, "2024-03-08T06:41:06.000000000");
     }
+    // the fraction follows the precision of the time point
+    L::i{}(std::chrono::time_point_cast<std::chrono::microseconds>(tpu)); EXPECT_EQ(message.substr(message.size() - 10), ":06.977543");
+    L::i{}(std::chrono::time_point_cast<std::chrono::milliseconds>(tpu)); EXPECT_EQ(message.substr(message.size() - 7), ":06.977");
+    L::i{}(std::chrono::time_point_cast<std::chrono::seconds>(tpu));      EXPECT_EQ(message.substr(message.size() - 3), ":06");
     unsetenv("TZ");
-    EXPECT_EQ(write_count, 4);
+    EXPECT_EQ(write_count, 7);
 }
 
 TEST_F(Structures, Duration) {
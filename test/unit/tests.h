@@ -10,8 +10,18 @@
 #include <gtest/gtest.h>
 #include <logovod/logovod.h>
 #include <logovod/sink/attributer.h>
+#include <logovod/config.h>
+#include <logovod/limit.h>
+#include <logovod/aggregate.h>
+#include <logovod/metric.h>
+#include <logovod/sink/dedup.h>
+#include <logovod/sink/joined.h>
+#include <logovod/shedding.h>
+#include <logovod/span.h>
+#include <logovod/sink/chrome.h>
 
 #include <filesystem>
+#include <vector>
  
 namespace logovod::tests {
 
@@ -54,7 +64,16 @@ struct Containers : LoggerTest {
         static constexpr std::size_t range_limit() noexcept { return 4; }
         static constexpr std::string_view trimmed() noexcept { return ".."; }
     };
+    struct ElementLimited : TestCategory {
+        static constexpr std::size_t element_limit() noexcept { return 5; }
+    };
+    struct ByteLimited : TestCategory {
+        static constexpr std::size_t length_limit = unlimited;
+        static constexpr std::size_t byte_limit() noexcept { return 12; }
+    };
     using R = logger<RangeLimited>;
+    using E = logger<ElementLimited>;
+    using B = logger<ByteLimited>;
 };
 
 struct Structures : LoggerTest {};
@@ -90,11 +109,18 @@ struct Delimiters : LoggerTest {
 struct Levels : LoggerTest {
     struct Warnings : TestCategory {
         static constexpr priority level() noexcept { return priority::warning; }
+        static constexpr bool elevatable = true;
     };
     using L = logger<Warnings>;
     
-    struct RuntimeLevel : runtime_level<RuntimeLevel, TestCategory> {};
+    struct RuntimeLevel : runtime_level<RuntimeLevel, TestCategory> {
+        static constexpr bool elevatable = true;
+    };
     using R = logger<RuntimeLevel>;
+    struct Fixed : Warnings {
+        static constexpr bool elevatable = false;
+    };
+    using F = logger<Fixed>;
     void SetUp() override {
         LoggerTest::SetUp();
         RuntimeLevel::level(priority::error);
@@ -108,8 +134,16 @@ struct Attributes : LoggerTest {
     struct CategoryB : TestCategory {
         static constexpr std::string_view tag = "B";
     };
+    struct LongTag : TestCategory {
+        static constexpr std::string_view tag = "a.category.tag.much.longer.than.the.tag.field.and.the.former.fragment.size";
+    };
+    struct Timed : TestCategory {
+        using clock_type = clock::system;
+        static constexpr auto prolog() noexcept { return sink::prolog::common<>; }
+    };
     using A = logger<CategoryA>;
     using B = logger<CategoryB>;
+    using T = logger<Timed>;
 };
 
 struct Buffer : LoggerTest {
@@ -125,10 +159,58 @@ struct Buffer : LoggerTest {
     struct Unlimited : TestCategory {
         static constexpr std::size_t length_limit = unlimited;
     };
+    struct Bounded : TestCategory {
+        static constexpr std::size_t length_limit = 128;
+    };
+    struct Spilled : TestCategory {
+        static constexpr std::size_t length_limit = 16;
+        static constexpr std::size_t spill_limit = 64;
+    };
+    struct SpilledTerminated : Spilled {
+        static constexpr sink_types::epiloger epilog() noexcept { return sink::epilog::eol; }
+    };
     using L = logger<Limited>;
     using T = logger<Terminated>;
     using U = logger<Unlimited>;
     using R = logger<Trimmed>;
+    using B = logger<Bounded>;
+    using S = logger<Spilled>;
+    using ST = logger<SpilledTerminated>;
+};
+
+struct Chunks : LoggerTest {
+    struct record {
+        std::string message;
+        std::string payload;
+        attributes attrs;
+    };
+    inline static std::vector<record> records {};
+    static void collect(std::string_view msg, std::string_view load, attributes a) noexcept {
+        records.push_back({ std::string { msg }, std::string { load }, a });
+        testsink(msg, load, a);
+    }
+    struct Chunked : TestCategory {
+        static constexpr std::size_t length_limit = 48;
+        static constexpr bool chunked = true;
+        static constexpr std::string_view tag = "C";
+        static constexpr sink_types::writer_type writer() noexcept { return collect; }
+        static constexpr sink_types::prologer prolog() noexcept { return sink::prolog::taglvl; }
+        static constexpr sink_types::epiloger epilog() noexcept { return sink::epilog::eol; }
+    };
+    struct Joined : Chunked {
+        static constexpr sink_types::writer_type writer() noexcept { return sink::joined<LoggerTest::testsink>; }
+    };
+    using C = logger<Chunked>;
+    using J = logger<Joined>;
+    void SetUp() override {
+        LoggerTest::SetUp();
+        records.clear();
+    }
+    static std::string joined() {
+        std::string result {};
+        for (const auto& r : records) result += r.payload;
+        return result;
+    }
 };
 
 struct FunctorSink {
@@ -160,9 +242,24 @@ struct Sinks : LoggerTest {
         static inline FunctorSink sink{};
         static constexpr std::string_view tag = "F";
     };
+    struct Deduplicated : TestCategory {
+        static constexpr auto writer() noexcept { return sink::dedup<LoggerTest::testsink, 50>; }
+        static constexpr auto epilog() noexcept { return sink::epilog::eol; }
+        static constexpr std::string_view tag = "D";
+    };
+    struct Other : Deduplicated {
+        static constexpr std::string_view tag = "O";
+    };
+    struct Prefixed : Deduplicated {
+        static constexpr std::string_view tag = "P";
+        static constexpr auto prolog() noexcept { return sink::prolog::taglvl; }
+    };
     using L = logger<RuntimeCategory1>;
     using R = logger<RuntimeCategory2>;
     using F = logger<FunctorCategory>;
+    using D = logger<Deduplicated>;
+    using O = logger<Other>;
+    using P = logger<Prefixed>;
     void SetUp() override {
         LoggerTest::SetUp();
         FunctorCategory::sink = FunctorSink{};
@@ -216,6 +313,138 @@ struct Optional : LoggerTest {
     }
 };
 
+struct Config : LoggerTest {
+    struct Http : runtime_level<Http, TestCategory> {
+        static constexpr std::string_view tag = "net.http";
+        static constexpr bool overridable = true;
+    };
+    struct Tcp : runtime_level<Tcp, TestCategory> {
+        static constexpr std::string_view tag = "net.tcp";
+    };
+    struct Db : runtime_level<Db, TestCategory> {
+        static constexpr std::string_view tag = "db";
+        static constexpr bool overridable = true;
+    };
+    struct Base : TestCategory {
+        static constexpr priority level() noexcept { return priority::error; }
+    };
+    struct Cache : optional_all<Cache, Base> {
+        static constexpr std::string_view tag = "db.cache";
+    };
+    struct Routed : runtime_sink<Routed, runtime_level<Routed, Base>> {
+        static constexpr std::string_view tag = "routed";
+    };
+    using H = logger<Http>;
+    using T = logger<Tcp>;
+    using R = logger<Routed>;
+    using D = logger<Db>;
+    using C = logger<Cache>;
+    void SetUp() override {
+        LoggerTest::SetUp();
+        config::apply("net.*=debug db=debug db.cache=default");
+        local = "";
+    }
+    void TearDown() override {
+        config::filter("");
+    }
+    static inline std::string local {};
+};
+
+struct Limits : LoggerTest {
+    struct First : TestCategory {
+        static constexpr auto limiter() noexcept { return limit::first { 2 }; }
+    };
+    struct Every : TestCategory {
+        static constexpr auto limiter() noexcept { return limit::every { 3 }; }
+    };
+    struct Bucket : TestCategory {
+        static constexpr auto limiter() noexcept { return limit::token_bucket { 3, std::chrono::hours { 1 } }; }
+    };
+    struct Sample : TestCategory {
+        static constexpr auto limiter() noexcept { return limit::sample { 4 }; }
+    };
+};
+
+struct Shedding : LoggerTest {
+    struct Busy : shed_level<Busy, TestCategory> {
+        static constexpr std::string_view tag = "busy";
+    };
+    struct Child : optional_level<Child, Busy> {};
+    using B = logger<Busy>;
+    using C = logger<Child>;
+    static inline std::string event {};
+    void SetUp() override {
+        LoggerTest::SetUp();
+        event.clear();
+        shedding::events::writer([](std::string_view msg, std::string_view, attributes) noexcept { event = msg; });
+        shedding::governor::configure({ std::chrono::milliseconds { 1 }, std::chrono::microseconds { 100 }, 1000, 100, priority::warning });
+    }
+    void TearDown() override {
+        shedding::governor::configure({});
+        shedding::events::nosink();
+    }
+};
+
+struct Aggregate : LoggerTest {
+    struct Hot : aggregated<Hot, TestCategory, 4> {
+        static constexpr std::string_view tag = "hot";
+    };
+    using H = logger<Hot>;
+};
+
+struct Metrics : LoggerTest {
+    struct Measured : TestCategory {
+        static constexpr std::string_view tag = "measured";
+    };
+    struct Quiet : TestCategory {
+        static constexpr priority level() noexcept { return priority::warning; }
+    };
+    using M = logger<Measured>;
+    using Q = logger<Quiet>;
+};
+
+struct Backlog : LoggerTest {
+    static inline std::vector<std::string> messages {};
+    static void collect(std::string_view msg, std::string_view load, attributes a) noexcept {
+        testsink(msg, load, a);
+        messages.emplace_back(load);
+    }
+    struct Captured : TestCategory {
+        static constexpr priority level() noexcept { return priority::warning; }
+        static constexpr std::size_t backlog() noexcept { return 4; }
+        static constexpr auto writer() noexcept { return collect; }
+    };
+    using B = logger<Captured>;
+    void SetUp() override {
+        LoggerTest::SetUp();
+        messages.clear();
+        detail::backlog<Captured>::dump([](std::string_view, std::string_view, attributes) noexcept {});
+    }
+};
+
+struct Context : LoggerTest {
+    struct Stamped : TestCategory {
+        static constexpr auto prolog() noexcept { return sink::prolog::common<>; }
+    };
+    using L = logger<TestCategory>;
+    using S = logger<Stamped>;
+};
+
+struct Spans : LoggerTest {
+    struct Quiet : TestCategory {
+        static constexpr priority level() noexcept { return priority::warning; }
+    };
+    static inline std::vector<trace::event> events {};
+    static void collect(const trace::event& e) noexcept { events.push_back(e); }
+    void SetUp() override {
+        LoggerTest::SetUp();
+        events.clear();
+    }
+    void TearDown() override {
+        trace::writer(nullptr);
+    }
+};
+
 struct Wchar : testing::Test {
     void SetUp() override {
         message.clear();
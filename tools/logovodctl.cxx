@@ -0,0 +1,53 @@
+/*
+ * Copyright (C) 2024 Eugene Hutorny <eugene@hutorny.in.ua>
+ *
+ * This file is a part of logovod library
+ *
+ * Licensed under MIT License, see full text in LICENSE
+ * or visit page https://opensource.org/license/mit/
+ */
+
+// Command line client for the administrative socket, see include/logovod/admin.h
+// Usage: logovodctl <socket> <command> [arguments...]
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+#include <cstdio>
+#include <cstring>
+#include <string>
+
+int main(int argc, char* argv[]) {
+    if (argc < 3) {
+        std::fprintf(stderr, "usage: %s <socket> <command> [arguments...]\n"
+            "commands: list, level <pattern> <level>, sink <pattern> <sink>, site <file:line> <level>, config, stats\n", argv[0]);
+        return 2;
+    }
+    sockaddr_un address {};
+    address.sun_family = AF_UNIX;
+    if (std::strlen(argv[1]) >= sizeof(address.sun_path)) {
+        std::fprintf(stderr, "%s: socket path is too long\n", argv[0]);
+        return 2;
+    }
+    std::strncpy(address.sun_path, argv[1], sizeof(address.sun_path) - 1);
+    const int fd { ::socket(AF_UNIX, SOCK_STREAM, 0) };
+    if (fd == -1 || ::connect(fd, reinterpret_cast<const sockaddr*>(&address), sizeof(address)) != 0) {
+        std::perror(argv[1]);
+        return 1;
+    }
+    std::string command { argv[2] };
+    for (int i = 3; i < argc; ++i) command.append(" ").append(argv[i]);
+    command.append("\n");
+    if (::write(fd, command.data(), command.size()) != static_cast<ssize_t>(command.size())) {
+        std::perror(argv[1]);
+        return 1;
+    }
+    ::shutdown(fd, SHUT_WR);
+    char buffer[4096];
+    bool failed {};
+    for (ssize_t size; (size = ::read(fd, buffer, sizeof(buffer))) > 0; ) {
+        failed = failed || std::strncmp(buffer, "error:", 6) == 0;
+        std::fwrite(buffer, 1, static_cast<std::size_t>(size), stdout);
+    }
+    ::close(fd);
+    return failed ? 1 : 0;
+}